@@ -4,6 +4,7 @@
 #include <NAS2D/Resources/Image.h>
 #include <NAS2D/Resources/Music.h>
 #include <NAS2D/Resources/ResourceCache.h>
+#include <NAS2D/Resources/Sprite.h>
 
 #include <memory>
 
@@ -11,4 +12,16 @@
 inline NAS2D::ResourceCache<NAS2D::Font, std::string, unsigned int> fontCache;
 inline NAS2D::ResourceCache<NAS2D::Image, std::string> imageCache;
 
+/**
+ * Parsed sprites keyed by sprite path and initial action. Things copy a
+ * cached sprite instead of parsing its .sprite file again.
+ *
+ * \note	NAS2D::Sprite keeps its frame lists and its playback state
+ *			(action, frame, timer, color) together as private members and
+ *			can only be drawn through itself, so a Thing can't hold a
+ *			cursor into a shared definition. bench/SpriteBench.cpp measures
+ *			the copy against parsing.
+ */
+inline NAS2D::ResourceCache<NAS2D::Sprite, std::string, std::string> spriteCache;
+
 inline std::unique_ptr<NAS2D::Music> trackMars;
@@ -5,6 +5,7 @@
 #include <NAS2D/StringUtils.h>
 
 #include <array>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -45,7 +46,7 @@ enum class Direction
 /**
  * Terrain type enumeration
  */
-enum class TerrainType
+enum class TerrainType : std::uint8_t
 {
 	Dozed,
 	Clear,
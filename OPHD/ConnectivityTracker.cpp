@@ -0,0 +1,81 @@
+#include "ConnectivityTracker.h"
+
+#include "Map/TileMap.h"
+
+
+ConnectivityTracker::ConnectivityTracker()
+{
+	Tile::changed().connect(this, &ConnectivityTracker::onTileChanged);
+}
+
+
+ConnectivityTracker::~ConnectivityTracker()
+{
+	Tile::changed().disconnect(this, &ConnectivityTracker::onTileChanged);
+}
+
+
+/**
+ * Forgets the connected set without touching any tiles. Used when the
+ * TileMap is replaced. The next update() walks from scratch.
+ */
+void ConnectivityTracker::reset()
+{
+	mTiles.clear();
+	mChangedTiles.clear();
+	mRoot = nullptr;
+	mFullWalk = true;
+}
+
+
+/**
+ * Brings the connected() flag of every tile up to date.
+ *
+ * \param	root	Tile holding the Command Center, or nullptr if there is no
+ *					working Command Center and nothing should be connected.
+ */
+void ConnectivityTracker::update(TileMap& tileMap, Tile* root)
+{
+	if (root != mRoot)
+	{
+		mRoot = root;
+		mFullWalk = true;
+	}
+
+	if (mFullWalk)
+	{
+		for (auto tile : mTiles)
+		{
+			tile->connected(false);
+		}
+		mTiles.clear();
+
+		if (mRoot) { mWalker.walk(mRoot->position(), mRoot->depth(), tileMap, mTiles); }
+	}
+	else if (mRoot)
+	{
+		for (auto changedTile : mChangedTiles)
+		{
+			auto& tile = tileMap.getTile(changedTile->position(), changedTile->depth());
+			mWalker.extend(tile, tileMap, mTiles);
+		}
+	}
+
+	mChangedTiles.clear();
+	mFullWalk = false;
+}
+
+
+void ConnectivityTracker::onTileChanged(const Tile& tile)
+{
+	if (mFullWalk) { return; }
+
+	if (tile.connected())
+	{
+		mFullWalk = true;
+		mChangedTiles.clear();
+		return;
+	}
+
+	mChangedTiles.push_back(&tile);
+}
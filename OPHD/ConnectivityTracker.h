@@ -0,0 +1,45 @@
+#pragma once
+
+#include "GraphWalker.h"
+
+#include "Map/Tile.h"
+
+#include <vector>
+
+
+class TileMap;
+
+
+/**
+ * Keeps the set of structures connected to the Command Center up to date
+ * as tiles change.
+ *
+ * Listens for Tile::changed(). A change to a tile that isn't connected can
+ * only add to the connected set, so it's handled by walking outward from
+ * that tile if a connected neighbor connects into it. A change to a
+ * connected tile can cut the network, so the connected set is walked again
+ * from the Command Center. When nothing changed, update() does nothing.
+ */
+class ConnectivityTracker
+{
+public:
+	ConnectivityTracker();
+	ConnectivityTracker(const ConnectivityTracker&) = delete;
+	ConnectivityTracker& operator=(const ConnectivityTracker&) = delete;
+	~ConnectivityTracker();
+
+	void reset();
+	void update(TileMap& tileMap, Tile* root);
+
+	const TileList& tiles() const { return mTiles; }
+
+private:
+	void onTileChanged(const Tile& tile);
+
+	GraphWalker mWalker;
+
+	TileList mTiles; /**< Connected tiles, starting with the root. */
+	std::vector<const Tile*> mChangedTiles; /**< Tiles that weren't connected when they changed. */
+	Tile* mRoot = nullptr;
+	bool mFullWalk = true;
+};
@@ -56,4 +56,5 @@ namespace constants
 
 	const float ROUTE_BASE_COST = 0.5f;
 	const float ROUTE_ROAD_COST = 0.25;
+	const int ROUTE_HIERARCHY_MIN_TILES = 300 * 150; /**< Surfaces larger than this find mine routes through a SectorGraph. */
 }
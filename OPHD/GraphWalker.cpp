@@ -1,6 +1,8 @@
 #include "GraphWalker.h"
 #include "DirectionOffset.h"
 
+#include "Map/TileMap.h"
+
 #include "Things/Structures/Structure.h"
 
 
@@ -73,50 +75,121 @@ static bool validConnection(Structure* src, Structure* dst, Direction direction)
 }
 
 
-GraphWalker::GraphWalker(const NAS2D::Point<int>& point, int depth, TileMap& tileMap, TileList& tileList) :
-	mTileMap{ tileMap },
-	mThisTile{ tileMap.getTile(point, depth) },
-	mTileList{ tileList },
-	mGridPosition{ point },
-	mDepth{ depth }
+/**
+ * Marks every structure connected to the one at the starting point.
+ *
+ * \param	tileList	Each connected tile is appended to this list,
+ *						starting with the tile at the starting point.
+ */
+void GraphWalker::walk(NAS2D::Point<int> position, int depth, TileMap& tileMap, TileList& tileList)
 {
-	walkGraph();
+	const auto tileCount = tileMap.tileIndex({0, 0}, tileMap.maxDepth() + 1);
+	if (mVisited.size() != tileCount)
+	{
+		mVisited.assign(tileCount, false);
+	}
+
+	const auto firstWalked = tileList.size();
+	visit(tileMap, tileMap.getTile(position, depth), tileList);
+
+	while (!mStack.empty())
+	{
+		auto& tile = *mStack.back();
+		mStack.pop_back();
+
+		const auto gridPosition = tile.position();
+		const auto tileDepth = tile.depth();
+
+		if (tileDepth > 0) { check(tileMap, tile, gridPosition, tileDepth - 1, Direction::Up, tileList); }
+		if (tileDepth < tileMap.maxDepth()) { check(tileMap, tile, gridPosition, tileDepth + 1, Direction::Down, tileList); }
+
+		check(tileMap, tile, gridPosition + DirectionNorth, tileDepth, Direction::North, tileList);
+		check(tileMap, tile, gridPosition + DirectionEast, tileDepth, Direction::East, tileList);
+		check(tileMap, tile, gridPosition + DirectionSouth, tileDepth, Direction::South, tileList);
+		check(tileMap, tile, gridPosition + DirectionWest, tileDepth, Direction::West, tileList);
+	}
+
+	// Only the walked tiles were marked so clearing them is cheaper than
+	// clearing the whole set.
+	for (auto i = firstWalked; i < tileList.size(); ++i)
+	{
+		mVisited[tileMap.tileIndex(tileList[i]->position(), tileList[i]->depth())] = false;
+	}
 }
 
 
-void GraphWalker::walkGraph()
+/**
+ * Adds a tile and everything newly reachable from it to an existing walk if
+ * a connected neighbor has a valid connection into it.
+ *
+ * \note	Tiles that are already connected are not walked again, so this
+ *			only ever grows the connected set.
+ */
+void GraphWalker::extend(Tile& tile, TileMap& tileMap, TileList& tileList)
 {
-	mThisTile.connected(true);
-	mTileList.push_back(&mThisTile);
+	if (tile.connected() || tile.hasMine() || !tile.excavated() || !tile.thingIsStructure()) { return; }
+
+	const auto position = tile.position();
+	const auto depth = tile.depth();
+
+	// Directions are from the neighbor into the tile.
+	if (connectsInto(tileMap, position + DirectionNorth, depth, Direction::South, tile) ||
+		connectsInto(tileMap, position + DirectionEast, depth, Direction::West, tile) ||
+		connectsInto(tileMap, position + DirectionSouth, depth, Direction::North, tile) ||
+		connectsInto(tileMap, position + DirectionWest, depth, Direction::East, tile) ||
+		connectsInto(tileMap, position, depth - 1, Direction::Down, tile) ||
+		connectsInto(tileMap, position, depth + 1, Direction::Up, tile))
+	{
+		walk(position, depth, tileMap, tileList);
+	}
+}
 
-	if (mDepth > 0) { check(mGridPosition, mDepth - 1, Direction::Up); }
-	if (mDepth < mTileMap.maxDepth()) { check(mGridPosition, mDepth + 1, Direction::Down); }
 
-	check(mGridPosition + DirectionNorth, mDepth, Direction::North);
-	check(mGridPosition + DirectionEast, mDepth, Direction::East);
-	check(mGridPosition + DirectionSouth, mDepth, Direction::South);
-	check(mGridPosition + DirectionWest, mDepth, Direction::West);
+void GraphWalker::visit(TileMap& tileMap, Tile& tile, TileList& tileList)
+{
+	mVisited[tileMap.tileIndex(tile.position(), tile.depth())] = true;
+	tile.connected(true);
+	tileList.push_back(&tile);
+	mStack.push_back(&tile);
 }
 
 
 /**
- * Checks a given map location for a valid connection.
- *
- * \todo	With Tile being updated to include position information, this function can be modified
- *			to take a source and destination tile instead of looking them up. By using the internal
- *			positional information in the Tiles we can deduce direction between source and destination.
+ * Checks a given map location for a valid connection from a source tile.
  */
-void GraphWalker::check(NAS2D::Point<int> point, int depth, Direction direction)
+void GraphWalker::check(TileMap& tileMap, Tile& source, NAS2D::Point<int> point, int depth, Direction direction, TileList& tileList)
 {
-	if (!NAS2D::Rectangle<int>::Create({0, 0}, mTileMap.size()).contains(point)) { return; }
-	if (depth < 0 || depth > mTileMap.maxDepth()) { return; }
+	if (!NAS2D::Rectangle<int>::Create({0, 0}, tileMap.size()).contains(point)) { return; }
+	if (depth < 0 || depth > tileMap.maxDepth()) { return; }
+
+	// Unexcavated tiles can't hold structures. Checked first so that walking past
+	// an untouched underground region doesn't allocate it.
+	if (!tileMap.excavated(point, depth)) { return; }
+	if (mVisited[tileMap.tileIndex(point, depth)]) { return; }
 
-	auto& tile = mTileMap.getTile(point, depth);
+	auto& tile = tileMap.getTileUnchecked(point, depth);
 
-	if (tile.connected() || tile.mine() || !tile.excavated() || !tile.thingIsStructure()) { return; }
+	if (tile.connected() || tile.hasMine() || !tile.excavated() || !tile.thingIsStructure()) { return; }
 
-	if (validConnection(mThisTile.structure(), tile.structure(), direction))
+	if (validConnection(source.structure(), tile.structure(), direction))
 	{
-		GraphWalker walker(point, depth, mTileMap, mTileList);
+		visit(tileMap, tile, tileList);
 	}
 }
+
+
+/**
+ * Checks whether a connected structure at a given map location has a valid
+ * connection into a destination tile.
+ */
+bool GraphWalker::connectsInto(TileMap& tileMap, NAS2D::Point<int> point, int depth, Direction direction, Tile& destination)
+{
+	if (!NAS2D::Rectangle<int>::Create({0, 0}, tileMap.size()).contains(point)) { return false; }
+	if (depth < 0 || depth > tileMap.maxDepth()) { return false; }
+	if (!tileMap.excavated(point, depth)) { return false; }
+
+	auto& tile = tileMap.getTileUnchecked(point, depth);
+	if (!tile.connected() || !tile.thingIsStructure()) { return false; }
+
+	return validConnection(tile.structure(), destination.structure(), direction);
+}
@@ -2,35 +2,37 @@
 
 #include "Common.h"
 
-#include "Map/TileMap.h"
+#include "Map/Tile.h"
 
 #include <NAS2D/Renderer/Point.h>
 
+#include <vector>
+
+
+class TileMap;
+
 
 /**
  * \brief	GraphWalker does a basic depth-first connection check
  *			on a TileMap given a starting point.
+ *
+ * The walk is iterative with an explicit stack, so network size is not
+ * limited by call stack depth. Visited tiles are tracked in a bitset
+ * indexed by TileMap::tileIndex(). The stack and bitset are kept between
+ * walks so a walker that is reused doesn't allocate once warmed up.
  */
 class GraphWalker
 {
 public:
-	GraphWalker(const NAS2D::Point<int>&, int, TileMap&, TileList&);
-	~GraphWalker() = default;
+	void walk(NAS2D::Point<int> position, int depth, TileMap& tileMap, TileList& tileList);
+	void extend(Tile& tile, TileMap& tileMap, TileList& tileList);
 
 private:
-	GraphWalker() = delete;
-	GraphWalker(GraphWalker&) = delete;
-	GraphWalker& operator=(const GraphWalker&) = delete;
+	void check(TileMap& tileMap, Tile& source, NAS2D::Point<int> point, int depth, Direction direction, TileList& tileList);
+	bool connectsInto(TileMap& tileMap, NAS2D::Point<int> point, int depth, Direction direction, Tile& destination);
+	void visit(TileMap& tileMap, Tile& tile, TileList& tileList);
 
 private:
-	void walkGraph();
-	void check(NAS2D::Point<int> point, int depth, Direction direction);
-
-private:
-	TileMap& mTileMap;
-	Tile& mThisTile;
-	TileList& mTileList;
-
-	NAS2D::Point<int> mGridPosition;
-	int mDepth{ 0 };
+	std::vector<Tile*> mStack; /**< Tiles visited but not yet expanded. */
+	std::vector<bool> mVisited; /**< Set for tiles reached during the current walk. */
 };
@@ -0,0 +1,126 @@
+#include "CommRangeGrid.h"
+
+#include "TileMap.h"
+
+#include "../States/MapViewStateHelper.h"
+
+#include <algorithm>
+
+
+/**
+ * Sizes the grid for a map. Transmitters already added are counted again
+ * for the new size.
+ */
+void CommRangeGrid::reset(NAS2D::Vector<int> mapSize)
+{
+	mSize = mapSize;
+	mCoverage.assign(static_cast<std::size_t>(mSize.x) * static_cast<std::size_t>(mSize.y), 0);
+
+	for (const auto& [structure, transmitter] : mTransmitters)
+	{
+		addCoverage(transmitter, 1);
+	}
+
+	mChanged = true;
+}
+
+
+/**
+ * Removes all transmitters.
+ */
+void CommRangeGrid::clear()
+{
+	std::fill(mCoverage.begin(), mCoverage.end(), static_cast<std::uint16_t>(0));
+	mTransmitters.clear();
+	mChanged = true;
+}
+
+
+/**
+ * Adds the coverage of an operational transmitter. Does nothing if the
+ * structure is already counted.
+ */
+void CommRangeGrid::addTransmitter(const Structure* structure, NAS2D::Point<int> position, int range)
+{
+	if (mTransmitters.find(structure) != mTransmitters.end()) { return; }
+
+	const Transmitter transmitter{position, range};
+	addCoverage(transmitter, 1);
+	mTransmitters[structure] = transmitter;
+	mChanged = true;
+}
+
+
+/**
+ * Removes the coverage of a transmitter. Does nothing if the structure
+ * isn't counted.
+ */
+void CommRangeGrid::removeTransmitter(const Structure* structure)
+{
+	const auto it = mTransmitters.find(structure);
+	if (it == mTransmitters.end()) { return; }
+
+	addCoverage(it->second, -1);
+	mTransmitters.erase(it);
+	mChanged = true;
+}
+
+
+/**
+ * Indicates whether a surface tile is within range of an operational
+ * Command Center or Communications Tower.
+ */
+bool CommRangeGrid::covered(NAS2D::Point<int> position) const
+{
+	if (!NAS2D::Rectangle<int>::Create({0, 0}, mSize).contains(position)) { return false; }
+	return mCoverage[static_cast<std::size_t>(position.y) * static_cast<std::size_t>(mSize.x) + static_cast<std::size_t>(position.x)] > 0;
+}
+
+
+/**
+ * Fills a list with every covered surface tile.
+ */
+void CommRangeGrid::coveredTiles(TileMap& tileMap, TileList& tileList) const
+{
+	tileList.clear();
+	for (int y = 0; y < mSize.y; ++y)
+	{
+		for (int x = 0; x < mSize.x; ++x)
+		{
+			if (covered({x, y})) { tileList.push_back(&tileMap.getTile({x, y}, 0)); }
+		}
+	}
+}
+
+
+/**
+ * Gets whether coverage changed since the last call and clears the flag.
+ */
+bool CommRangeGrid::takeChanged()
+{
+	const bool changed = mChanged;
+	mChanged = false;
+	return changed;
+}
+
+
+void CommRangeGrid::addCoverage(const Transmitter& transmitter, int amount)
+{
+	const auto& center = transmitter.position;
+	const auto startX = std::max(center.x - transmitter.range, 0);
+	const auto startY = std::max(center.y - transmitter.range, 0);
+	const auto endX = std::min(center.x + transmitter.range, mSize.x - 1);
+	const auto endY = std::min(center.y + transmitter.range, mSize.y - 1);
+
+	for (int y = startY; y <= endY; ++y)
+	{
+		for (int x = startX; x <= endX; ++x)
+		{
+			if (isPointInRange(center, {x, y}, transmitter.range))
+			{
+				auto& coverage = mCoverage[static_cast<std::size_t>(y) * static_cast<std::size_t>(mSize.x) + static_cast<std::size_t>(x)];
+				coverage = static_cast<std::uint16_t>(coverage + amount);
+			}
+		}
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Tile.h"
+
+#include <NAS2D/Renderer/Point.h>
+#include <NAS2D/Renderer/Vector.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+
+class Structure;
+class TileMap;
+
+
+/**
+ * Number of operational Command Centers and Communications Towers covering
+ * each surface tile.
+ *
+ * The StructureManager adds and removes transmitters as structures are
+ * added, removed or change state, so only the footprint of the structure
+ * that changed is touched and checking whether a tile is in range is a
+ * single lookup.
+ */
+class CommRangeGrid
+{
+public:
+	void reset(NAS2D::Vector<int> mapSize);
+	void clear();
+
+	void addTransmitter(const Structure* structure, NAS2D::Point<int> position, int range);
+	void removeTransmitter(const Structure* structure);
+
+	bool covered(NAS2D::Point<int> position) const;
+	void coveredTiles(TileMap& tileMap, TileList& tileList) const;
+
+	bool takeChanged();
+
+private:
+	struct Transmitter
+	{
+		NAS2D::Point<int> position;
+		int range = 0;
+	};
+
+	void addCoverage(const Transmitter& transmitter, int amount);
+
+	NAS2D::Vector<int> mSize;
+	std::vector<std::uint16_t> mCoverage; /**< Transmitters in range of each surface tile. */
+	std::unordered_map<const Structure*, Transmitter> mTransmitters; /**< Transmitters currently counted in mCoverage. */
+	bool mChanged = true; /**< Coverage changed since the last call to takeChanged(). */
+};
@@ -0,0 +1,365 @@
+#include "GridPathfinder.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+
+namespace
+{
+	constexpr auto Closed = std::numeric_limits<std::size_t>::max();
+
+
+	NAS2D::Rectangle<int> wholeGrid(const RouteCostGrid& grid)
+	{
+		return {0, 0, grid.size.x, grid.size.y};
+	}
+}
+
+
+float GridPathfinder::findPath(const RouteCostGrid& grid, std::size_t start, std::size_t goal, Path& path)
+{
+	return findPath(grid, start, goal, path, wholeGrid(grid));
+}
+
+
+/**
+ * Finds the cheapest path between two tiles with A*.
+ *
+ * Stepping onto a tile costs its entry in RouteCostGrid::cost, except for
+ * the goal which costs its RouteCostGrid::endpointCost. The heuristic is the
+ * Manhattan distance scaled by the cheapest step in the grid so it never
+ * overestimates and the path found is always the cheapest one.
+ *
+ * \param	path	Receives the path from start to goal, inclusive. Cleared
+ *					if there is no path.
+ * \param	bounds	Area of the grid the path must stay within. Must contain
+ *					both start and goal.
+ *
+ * \return	Cost of the path or FLT_MAX if the goal can't be reached.
+ */
+float GridPathfinder::findPath(const RouteCostGrid& grid, std::size_t start, std::size_t goal, Path& path, const NAS2D::Rectangle<int>& bounds)
+{
+	path.clear();
+	beginSearch(grid, bounds);
+
+	const auto width = static_cast<std::size_t>(mSize.x);
+	const auto goalX = static_cast<int>(goal % width);
+	const auto goalY = static_cast<int>(goal / width);
+	const float heuristicScale = grid.minimumCost == FLT_MAX ? 0.0f : grid.minimumCost;
+	const auto estimate = [&](std::size_t index)
+	{
+		const auto dx = std::abs(static_cast<int>(index % width) - goalX);
+		const auto dy = std::abs(static_cast<int>(index / width) - goalY);
+		return heuristicScale * static_cast<float>(dx + dy);
+	};
+
+	relax(start, 0.0f, estimate(start), NoTile);
+
+	while (!mHeap.empty())
+	{
+		const auto index = heapPop();
+		if (index == goal)
+		{
+			for (auto step = goal; step != NoTile; step = mParent[step])
+			{
+				path.push_back(step);
+			}
+			std::reverse(path.begin(), path.end());
+			return mCost[goal];
+		}
+
+		std::size_t adjacent[4];
+		const auto count = neighbors(index, adjacent);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const auto neighbor = adjacent[i];
+			const float stepCost = neighbor == goal ? grid.endpointCost[neighbor] : grid.cost[neighbor];
+			if (stepCost == FLT_MAX) { continue; }
+
+			const float cost = mCost[index] + stepCost;
+			if (cost < costTo(neighbor))
+			{
+				relax(neighbor, cost, cost + estimate(neighbor), index);
+			}
+		}
+	}
+
+	return FLT_MAX;
+}
+
+
+void GridPathfinder::searchFrom(const RouteCostGrid& grid, const Path& destinations, const Path& origins)
+{
+	searchFrom(grid, destinations, origins, wholeGrid(grid));
+}
+
+
+/**
+ * Finds the cheapest path from each origin to its nearest destination with
+ * a single multi-source Dijkstra search.
+ *
+ * The search runs backwards from the destinations. The cost of a step is
+ * the cost of entering the tile the step leads to, so expanding a tile
+ * charges its own entry cost to the neighbors that lead into it.
+ * Destinations are charged as route endpoints. The search stops once all
+ * origins are settled.
+ *
+ * Read the results with pathFrom() before starting another search.
+ *
+ * \param	bounds	Area of the grid paths must stay within. Must contain
+ *					all of the destinations and origins.
+ */
+void GridPathfinder::searchFrom(const RouteCostGrid& grid, const Path& destinations, const Path& origins, const NAS2D::Rectangle<int>& bounds)
+{
+	beginSearch(grid, bounds);
+
+	std::size_t originsRemaining = 0;
+	for (auto origin : origins)
+	{
+		if (mOriginGeneration[origin] != mCurrentGeneration) { ++originsRemaining; }
+		mOriginGeneration[origin] = mCurrentGeneration;
+	}
+
+	for (auto destination : destinations)
+	{
+		relax(destination, 0.0f, 0.0f, NoTile);
+	}
+
+	while (!mHeap.empty() && originsRemaining > 0)
+	{
+		const auto index = heapPop();
+
+		if (mOriginGeneration[index] == mCurrentGeneration)
+		{
+			mOriginGeneration[index] = 0;
+			--originsRemaining;
+		}
+
+		const float entryCost = mParent[index] == NoTile ? grid.endpointCost[index] : grid.cost[index];
+		if (entryCost == FLT_MAX) { continue; }
+
+		const float cost = mCost[index] + entryCost;
+
+		std::size_t adjacent[4];
+		const auto count = neighbors(index, adjacent);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const auto neighbor = adjacent[i];
+			if (cost < costTo(neighbor))
+			{
+				relax(neighbor, cost, cost, index);
+			}
+		}
+	}
+}
+
+
+/**
+ * Reads the path from an origin to its nearest destination found by the
+ * last call to searchFrom().
+ *
+ * \param	path	Receives the path from the origin to the destination,
+ *					inclusive. Cleared if there is no path.
+ *
+ * \return	Cost of the path or FLT_MAX if no destination could be reached.
+ */
+float GridPathfinder::pathFrom(std::size_t origin, Path& path) const
+{
+	path.clear();
+	if (settledCost(origin) == FLT_MAX) { return FLT_MAX; }
+
+	for (auto step = origin; step != NoTile; step = mParent[step])
+	{
+		path.push_back(step);
+	}
+
+	return mCost[origin];
+}
+
+
+/**
+ * Finds the cost from a tile to every other tile in an area with a
+ * forward Dijkstra search. Unlike findPath() no tile is charged as an
+ * endpoint.
+ *
+ * Read the results with settledCost() before starting another search.
+ */
+void GridPathfinder::searchWithin(const RouteCostGrid& grid, std::size_t start, const NAS2D::Rectangle<int>& bounds)
+{
+	beginSearch(grid, bounds);
+	relax(start, 0.0f, 0.0f, NoTile);
+
+	while (!mHeap.empty())
+	{
+		const auto index = heapPop();
+
+		std::size_t adjacent[4];
+		const auto count = neighbors(index, adjacent);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const auto neighbor = adjacent[i];
+			const float stepCost = grid.cost[neighbor];
+			if (stepCost == FLT_MAX) { continue; }
+
+			const float cost = mCost[index] + stepCost;
+			if (cost < costTo(neighbor))
+			{
+				relax(neighbor, cost, cost, index);
+			}
+		}
+	}
+}
+
+
+/**
+ * Gets the cost to a tile found by the last search, or FLT_MAX if the
+ * search didn't settle it.
+ */
+float GridPathfinder::settledCost(std::size_t index) const
+{
+	return touched(index) && mHeapPosition[index] == Closed ? mCost[index] : FLT_MAX;
+}
+
+
+/**
+ * Prepares the search arrays for a new search over a grid.
+ *
+ * The arrays are only reallocated when the grid size changes. Otherwise
+ * bumping the generation invalidates every entry at once.
+ */
+void GridPathfinder::beginSearch(const RouteCostGrid& grid, const NAS2D::Rectangle<int>& bounds)
+{
+	mBounds = bounds;
+
+	const auto tileCount = static_cast<std::size_t>(grid.size.x) * static_cast<std::size_t>(grid.size.y);
+	if (grid.size != mSize || mCost.size() != tileCount)
+	{
+		mSize = grid.size;
+		mCost.assign(tileCount, FLT_MAX);
+		mPriority.assign(tileCount, FLT_MAX);
+		mParent.assign(tileCount, NoTile);
+		mHeapPosition.assign(tileCount, Closed);
+		mGeneration.assign(tileCount, 0);
+		mOriginGeneration.assign(tileCount, 0);
+		mCurrentGeneration = 0;
+	}
+
+	if (++mCurrentGeneration == 0)
+	{
+		std::fill(mGeneration.begin(), mGeneration.end(), 0);
+		std::fill(mOriginGeneration.begin(), mOriginGeneration.end(), 0);
+		mCurrentGeneration = 1;
+	}
+
+	mHeap.clear();
+}
+
+
+/**
+ * Records a cheaper cost to a tile and adds it to the open list, or moves
+ * it up the open list if it's already there.
+ */
+void GridPathfinder::relax(std::size_t index, float cost, float priority, std::size_t parent)
+{
+	const bool open = touched(index) && mHeapPosition[index] != Closed;
+
+	mGeneration[index] = mCurrentGeneration;
+	mCost[index] = cost;
+	mPriority[index] = priority;
+	mParent[index] = parent;
+
+	if (open)
+	{
+		heapSiftUp(mHeapPosition[index]);
+	}
+	else
+	{
+		heapPush(index);
+	}
+}
+
+
+/**
+ * Gets the 4-connected neighbors of a tile that lie inside the search
+ * bounds.
+ *
+ * \return	Number of neighbors written to out.
+ */
+std::size_t GridPathfinder::neighbors(std::size_t index, std::size_t (&out)[4]) const
+{
+	const auto width = static_cast<std::size_t>(mSize.x);
+	const auto x = static_cast<int>(index % width);
+	const auto y = static_cast<int>(index / width);
+
+	std::size_t count = 0;
+	if (y > mBounds.y) { out[count++] = index - width; }
+	if (x + 1 < mBounds.x + mBounds.width) { out[count++] = index + 1; }
+	if (y + 1 < mBounds.y + mBounds.height) { out[count++] = index + width; }
+	if (x > mBounds.x) { out[count++] = index - 1; }
+	return count;
+}
+
+
+void GridPathfinder::heapPush(std::size_t index)
+{
+	mHeap.push_back(index);
+	mHeapPosition[index] = mHeap.size() - 1;
+	heapSiftUp(mHeap.size() - 1);
+}
+
+
+std::size_t GridPathfinder::heapPop()
+{
+	const auto top = mHeap.front();
+	mHeapPosition[top] = Closed;
+
+	const auto last = mHeap.back();
+	mHeap.pop_back();
+	if (!mHeap.empty())
+	{
+		mHeap.front() = last;
+		mHeapPosition[last] = 0;
+		heapSiftDown(0);
+	}
+
+	return top;
+}
+
+
+void GridPathfinder::heapSiftUp(std::size_t position)
+{
+	const auto index = mHeap[position];
+	while (position > 0)
+	{
+		const auto parent = (position - 1) / 2;
+		if (mPriority[mHeap[parent]] <= mPriority[index]) { break; }
+
+		mHeap[position] = mHeap[parent];
+		mHeapPosition[mHeap[position]] = position;
+		position = parent;
+	}
+
+	mHeap[position] = index;
+	mHeapPosition[index] = position;
+}
+
+
+void GridPathfinder::heapSiftDown(std::size_t position)
+{
+	const auto index = mHeap[position];
+	const auto size = mHeap.size();
+	while (true)
+	{
+		auto child = position * 2 + 1;
+		if (child >= size) { break; }
+		if (child + 1 < size && mPriority[mHeap[child + 1]] < mPriority[mHeap[child]]) { ++child; }
+		if (mPriority[index] <= mPriority[mHeap[child]]) { break; }
+
+		mHeap[position] = mHeap[child];
+		mHeapPosition[mHeap[position]] = position;
+		position = child;
+	}
+
+	mHeap[position] = index;
+	mHeapPosition[index] = position;
+}
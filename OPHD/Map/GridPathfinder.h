@@ -0,0 +1,84 @@
+#pragma once
+
+#include <NAS2D/Renderer/Rectangle.h>
+#include <NAS2D/Renderer/Vector.h>
+
+#include <cfloat>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+/**
+ * Snapshot of the cost of moving onto each surface tile.
+ *
+ * Tiles are addressed by their surface index, y * width + x.
+ */
+struct RouteCostGrid
+{
+	NAS2D::Vector<int> size;
+
+	std::vector<float> cost; /**< Cost to pass through a tile. FLT_MAX if it can't be passed through. */
+	std::vector<float> endpointCost; /**< Cost to enter a tile as the start or end of a route. */
+
+	float minimumCost = FLT_MAX; /**< Cheapest passable entry in cost. Scales the A* heuristic. */
+};
+
+
+/**
+ * A* and multi-source Dijkstra searches over a 4-connected RouteCostGrid.
+ *
+ * All per-node search state lives in flat arrays indexed by tile index.
+ * The arrays are allocated once and reused between searches. A
+ * generation counter marks which entries belong to the current search,
+ * so starting a new search doesn't need to clear them.
+ *
+ * Searches can be limited to a rectangle of the grid. Tiles outside of it
+ * are treated as impassable.
+ *
+ * \note	Not thread safe. Use one GridPathfinder per thread. A single
+ *			RouteCostGrid may be shared between them.
+ */
+class GridPathfinder
+{
+public:
+	using Path = std::vector<std::size_t>;
+
+	static constexpr auto NoTile = std::numeric_limits<std::size_t>::max();
+
+	float findPath(const RouteCostGrid& grid, std::size_t start, std::size_t goal, Path& path);
+	float findPath(const RouteCostGrid& grid, std::size_t start, std::size_t goal, Path& path, const NAS2D::Rectangle<int>& bounds);
+
+	void searchFrom(const RouteCostGrid& grid, const Path& destinations, const Path& origins);
+	void searchFrom(const RouteCostGrid& grid, const Path& destinations, const Path& origins, const NAS2D::Rectangle<int>& bounds);
+	float pathFrom(std::size_t origin, Path& path) const;
+
+	void searchWithin(const RouteCostGrid& grid, std::size_t start, const NAS2D::Rectangle<int>& bounds);
+	float settledCost(std::size_t index) const;
+
+private:
+	void beginSearch(const RouteCostGrid& grid, const NAS2D::Rectangle<int>& bounds);
+
+	bool touched(std::size_t index) const { return mGeneration[index] == mCurrentGeneration; }
+	float costTo(std::size_t index) const { return touched(index) ? mCost[index] : FLT_MAX; }
+	void relax(std::size_t index, float cost, float priority, std::size_t parent);
+	std::size_t neighbors(std::size_t index, std::size_t (&out)[4]) const;
+
+	void heapPush(std::size_t index);
+	std::size_t heapPop();
+	void heapSiftUp(std::size_t position);
+	void heapSiftDown(std::size_t position);
+
+	NAS2D::Vector<int> mSize;
+	NAS2D::Rectangle<int> mBounds;
+
+	std::vector<float> mCost; /**< Cost from the search source to each tile. */
+	std::vector<float> mPriority; /**< Cost plus heuristic estimate. Orders the open list. */
+	std::vector<std::size_t> mParent; /**< Previous tile for A*, next tile toward the destination for searchFrom(). */
+	std::vector<std::size_t> mHeapPosition; /**< Position in mHeap, or Closed. */
+	std::vector<std::uint32_t> mGeneration; /**< Search that last wrote each tile's entries. */
+	std::vector<std::uint32_t> mOriginGeneration; /**< Marks tiles passed as origins to searchFrom(). */
+	std::uint32_t mCurrentGeneration = 0;
+
+	std::vector<std::size_t> mHeap; /**< Binary min heap of tile indexes ordered by mPriority. */
+};
@@ -0,0 +1,57 @@
+#include "RouteIndex.h"
+
+#include "Tile.h"
+#include "TileMap.h"
+
+#include <algorithm>
+
+
+void RouteIndex::add(MineFacility* facility, const Route& route, const TileMap& tileMap)
+{
+	remove(facility);
+
+	auto& routeTiles = mRouteTiles[facility];
+	routeTiles.reserve(route.path.size());
+
+	for (auto tile : route.path)
+	{
+		const auto index = tileMap.tileIndex(tile->position(), 0);
+		routeTiles.push_back(index);
+		mTileRoutes[index].push_back(facility);
+	}
+}
+
+
+void RouteIndex::remove(MineFacility* facility)
+{
+	const auto it = mRouteTiles.find(facility);
+	if (it == mRouteTiles.end()) { return; }
+
+	for (auto index : it->second)
+	{
+		auto& facilities = mTileRoutes[index];
+		facilities.erase(std::remove(facilities.begin(), facilities.end(), facility), facilities.end());
+		if (facilities.empty()) { mTileRoutes.erase(index); }
+	}
+
+	mRouteTiles.erase(it);
+}
+
+
+void RouteIndex::clear()
+{
+	mTileRoutes.clear();
+	mRouteTiles.clear();
+}
+
+
+/**
+ * Gets the routes that pass through a surface tile.
+ */
+const std::vector<MineFacility*>& RouteIndex::routesThrough(std::size_t tileIndex) const
+{
+	static const std::vector<MineFacility*> NoRoutes;
+
+	const auto it = mTileRoutes.find(tileIndex);
+	return it != mTileRoutes.end() ? it->second : NoRoutes;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../States/Route.h"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+
+class MineFacility;
+class TileMap;
+
+
+/**
+ * Tracks which surface tiles each mine route passes through so that a
+ * change to a tile only needs to recheck the routes that cross it.
+ */
+class RouteIndex
+{
+public:
+	void add(MineFacility* facility, const Route& route, const TileMap& tileMap);
+	void remove(MineFacility* facility);
+	void clear();
+
+	const std::vector<MineFacility*>& routesThrough(std::size_t tileIndex) const;
+
+private:
+	std::unordered_map<std::size_t, std::vector<MineFacility*>> mTileRoutes; /**< Surface tile index -> routes crossing it. */
+	std::map<MineFacility*, std::vector<std::size_t>> mRouteTiles; /**< Route -> surface tile indexes it crosses. */
+};
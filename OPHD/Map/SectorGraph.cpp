@@ -0,0 +1,444 @@
+#include "SectorGraph.h"
+
+#include "TileMap.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+
+
+namespace
+{
+	constexpr auto NoTile = GridPathfinder::NoTile;
+
+	using QueueEntry = std::pair<float, std::size_t>;
+	using OpenList = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+
+	/**
+	 * Places an entrance at the cheapest crossing of each open stretch of
+	 * a sector edge. Ties go to the crossing nearest the middle of the
+	 * stretch.
+	 *
+	 * \param	first	First tile on the near side of the edge.
+	 * \param	stride	Distance between tiles along the edge.
+	 * \param	across	Distance from a near side tile to the far side tile.
+	 */
+	void placeEntrances(const RouteCostGrid& grid, std::size_t first, std::size_t stride, std::size_t count, std::size_t across, std::vector<std::size_t>& entrances)
+	{
+		entrances.clear();
+
+		const auto crossingCost = [&](std::size_t i)
+		{
+			const auto tile = first + i * stride;
+			const float near = grid.cost[tile];
+			const float far = grid.cost[tile + across];
+			return near == FLT_MAX || far == FLT_MAX ? FLT_MAX : near + far;
+		};
+
+		std::size_t runStart = 0;
+		while (runStart < count)
+		{
+			if (crossingCost(runStart) == FLT_MAX)
+			{
+				++runStart;
+				continue;
+			}
+
+			auto runEnd = runStart;
+			while (runEnd < count && crossingCost(runEnd) != FLT_MAX) { ++runEnd; }
+
+			const auto middle = static_cast<int>(runStart + runEnd - 1);
+			auto best = runStart;
+			for (auto i = runStart + 1; i < runEnd; ++i)
+			{
+				const float cost = crossingCost(i);
+				const float bestCost = crossingCost(best);
+				if (cost < bestCost || (cost == bestCost && std::abs(2 * static_cast<int>(i) - middle) < std::abs(2 * static_cast<int>(best) - middle)))
+				{
+					best = i;
+				}
+			}
+
+			entrances.push_back(first + best * stride);
+			runStart = runEnd;
+		}
+	}
+}
+
+
+/**
+ * Starts over with a new copy of the map's route costs. Every sector is
+ * rebuilt by the next refresh().
+ */
+void SectorGraph::reset(const TileMap& tileMap)
+{
+	mGrid = tileMap.routeCostGrid();
+	mSizeInSectors = {(mGrid.size.x + SectorSize - 1) / SectorSize, (mGrid.size.y + SectorSize - 1) / SectorSize};
+
+	mSectors.clear();
+	mSectors.resize(static_cast<std::size_t>(mSizeInSectors.x) * static_cast<std::size_t>(mSizeInSectors.y));
+
+	mNodeTiles.clear();
+	mDestinations.clear();
+	mDestinationCost.clear();
+	mDestinationTile.clear();
+}
+
+
+/**
+ * Copies the route cost of changed surface tiles and marks their sectors
+ * for rebuilding.
+ *
+ * \param	changedTiles	Surface tile indexes as given by TileMap::takeChangedSurfaceTiles().
+ */
+void SectorGraph::update(const TileMap& tileMap, const std::vector<std::size_t>& changedTiles)
+{
+	if (mSectors.empty()) { return; }
+
+	const auto width = static_cast<std::size_t>(mGrid.size.x);
+	for (auto index : changedTiles)
+	{
+		const NAS2D::Point position{static_cast<int>(index % width), static_cast<int>(index / width)};
+		mGrid.cost[index] = tileMap.routeCost(position, false);
+		mGrid.endpointCost[index] = tileMap.routeCost(position, true);
+		mGrid.minimumCost = std::min({mGrid.minimumCost, mGrid.cost[index], mGrid.endpointCost[index]});
+
+		mSectors[sectorIndex(index)].dirty = true;
+	}
+}
+
+
+/**
+ * Rebuilds the entrances and node costs of sectors marked by update().
+ *
+ * \note	Clears the destinations. Call destinations() again before
+ *			finding routes.
+ */
+void SectorGraph::refresh(GridPathfinder& pathfinder)
+{
+	const auto sectorCount = mSectors.size();
+	const auto sectorsWide = static_cast<std::size_t>(mSizeInSectors.x);
+
+	std::vector<bool> rebuild(sectorCount, false);
+	for (std::size_t i = 0; i < sectorCount; ++i)
+	{
+		if (!mSectors[i].dirty) { continue; }
+
+		// A sector shares its west and north edges with its neighbors,
+		// which own the entrances along them.
+		buildEntrances(i);
+		if (i % sectorsWide > 0) { buildEntrances(i - 1); }
+		if (i >= sectorsWide) { buildEntrances(i - sectorsWide); }
+
+		rebuild[i] = true;
+		if (i % sectorsWide > 0) { rebuild[i - 1] = true; }
+		if (i % sectorsWide + 1 < sectorsWide) { rebuild[i + 1] = true; }
+		if (i >= sectorsWide) { rebuild[i - sectorsWide] = true; }
+		if (i + sectorsWide < sectorCount) { rebuild[i + sectorsWide] = true; }
+	}
+
+	if (std::find(rebuild.begin(), rebuild.end(), true) == rebuild.end()) { return; }
+
+	for (std::size_t i = 0; i < sectorCount; ++i)
+	{
+		if (rebuild[i]) { buildNodes(i, pathfinder); }
+		mSectors[i].dirty = false;
+	}
+
+	mNodeTiles.clear();
+	for (auto& sector : mSectors)
+	{
+		sector.firstNode = mNodeTiles.size();
+		mNodeTiles.insert(mNodeTiles.end(), sector.nodes.begin(), sector.nodes.end());
+	}
+
+	mDestinations.clear();
+	mDestinationCost.assign(mNodeTiles.size(), FLT_MAX);
+	mDestinationTile.assign(mNodeTiles.size(), NoTile);
+}
+
+
+/**
+ * Sets the tiles routes should end at and finds the cost from every node
+ * to the nearest destination in its sector.
+ */
+void SectorGraph::destinations(GridPathfinder& pathfinder, const GridPathfinder::Path& destinations)
+{
+	mDestinations.clear();
+	for (auto destination : destinations)
+	{
+		mDestinations[sectorIndex(destination)].push_back(destination);
+	}
+
+	mDestinationCost.assign(mNodeTiles.size(), FLT_MAX);
+	mDestinationTile.assign(mNodeTiles.size(), NoTile);
+
+	GridPathfinder::Path path;
+	for (const auto& [index, sectorDestinations] : mDestinations)
+	{
+		const auto& sector = mSectors[index];
+		pathfinder.searchFrom(mGrid, sectorDestinations, sector.nodes, sectorBounds(index));
+
+		for (std::size_t i = 0; i < sector.nodes.size(); ++i)
+		{
+			const float cost = pathfinder.pathFrom(sector.nodes[i], path);
+			if (cost == FLT_MAX) { continue; }
+
+			mDestinationCost[sector.firstNode + i] = cost;
+			mDestinationTile[sector.firstNode + i] = path.back();
+		}
+	}
+}
+
+
+/**
+ * Finds a route from a tile to the nearest destination.
+ *
+ * Searches the graph of sector entrances for the cheapest sequence of
+ * sectors, then joins the entrances with tile by tile paths that each stay
+ * within one sector.
+ *
+ * \param	path	Receives the route from start to destination, inclusive.
+ *					Cleared if there is no route.
+ *
+ * \return	Cost of the route or FLT_MAX if no destination was reached.
+ */
+float SectorGraph::findRoute(GridPathfinder& pathfinder, std::size_t start, GridPathfinder::Path& path) const
+{
+	path.clear();
+
+	const auto startSectorIndex = sectorIndex(start);
+	const auto& startSector = mSectors[startSectorIndex];
+	const auto startBounds = sectorBounds(startSectorIndex);
+
+	// The last entry stands for having reached a destination.
+	const auto arrived = mNodeTiles.size();
+	std::vector<float> cost(arrived + 1, FLT_MAX);
+	std::vector<std::size_t> parent(arrived + 1, NoTile);
+	OpenList open;
+
+	GridPathfinder::Path directPath;
+	const auto localDestinations = mDestinations.find(startSectorIndex);
+	if (localDestinations != mDestinations.end())
+	{
+		pathfinder.searchFrom(mGrid, localDestinations->second, {start}, startBounds);
+		cost[arrived] = pathfinder.pathFrom(start, directPath);
+		if (cost[arrived] != FLT_MAX) { open.push({cost[arrived], arrived}); }
+	}
+
+	pathfinder.searchWithin(mGrid, start, startBounds);
+	for (std::size_t i = 0; i < startSector.nodes.size(); ++i)
+	{
+		const auto node = startSector.firstNode + i;
+		cost[node] = pathfinder.settledCost(startSector.nodes[i]);
+		if (cost[node] != FLT_MAX) { open.push({cost[node], node}); }
+	}
+
+	const auto relax = [&](std::size_t node, float nodeCost, std::size_t from)
+	{
+		if (nodeCost < cost[node])
+		{
+			cost[node] = nodeCost;
+			parent[node] = from;
+			open.push({nodeCost, node});
+		}
+	};
+
+	const auto width = static_cast<std::size_t>(mGrid.size.x);
+	const auto height = static_cast<std::size_t>(mGrid.size.y);
+	const auto edge = static_cast<std::size_t>(SectorSize);
+
+	while (!open.empty())
+	{
+		const auto [nodeCost, node] = open.top();
+		open.pop();
+
+		if (nodeCost > cost[node]) { continue; }
+		if (node == arrived) { break; }
+
+		if (mDestinationCost[node] != FLT_MAX)
+		{
+			relax(arrived, nodeCost + mDestinationCost[node], node);
+		}
+
+		const auto tile = mNodeTiles[node];
+		const auto& sector = mSectors[sectorIndex(tile)];
+		const auto nodeCount = sector.nodes.size();
+		const auto local = node - sector.firstNode;
+		for (std::size_t i = 0; i < nodeCount; ++i)
+		{
+			const float edgeCost = sector.costs[local * nodeCount + i];
+			if (i == local || edgeCost == FLT_MAX) { continue; }
+			relax(sector.firstNode + i, nodeCost + edgeCost, node);
+		}
+
+		const auto x = tile % width;
+		const auto y = tile / width;
+		std::size_t across[4];
+		std::size_t acrossCount = 0;
+		if (y % edge == 0 && y > 0) { across[acrossCount++] = tile - width; }
+		if (x % edge == edge - 1 && x + 1 < width) { across[acrossCount++] = tile + 1; }
+		if (y % edge == edge - 1 && y + 1 < height) { across[acrossCount++] = tile + width; }
+		if (x % edge == 0 && x > 0) { across[acrossCount++] = tile - 1; }
+
+		for (std::size_t i = 0; i < acrossCount; ++i)
+		{
+			const auto acrossNode = nodeId(across[i]);
+			if (acrossNode == NoTile) { continue; }
+			relax(acrossNode, nodeCost + mGrid.cost[across[i]], node);
+		}
+	}
+
+	if (cost[arrived] == FLT_MAX) { return FLT_MAX; }
+
+	if (parent[arrived] == NoTile)
+	{
+		path = directPath;
+		return cost[arrived];
+	}
+
+	std::vector<std::size_t> nodes;
+	for (auto node = parent[arrived]; node != NoTile; node = parent[node])
+	{
+		nodes.push_back(node);
+	}
+	std::reverse(nodes.begin(), nodes.end());
+
+	path.push_back(start);
+	GridPathfinder::Path leg;
+	const auto appendLeg = [&](std::size_t to)
+	{
+		const auto from = path.back();
+		const auto index = sectorIndex(to);
+		if (sectorIndex(from) != index)
+		{
+			path.push_back(to);
+			return true;
+		}
+
+		if (pathfinder.findPath(mGrid, from, to, leg, sectorBounds(index)) == FLT_MAX) { return false; }
+		path.insert(path.end(), leg.begin() + 1, leg.end());
+		return true;
+	};
+
+	for (auto node : nodes)
+	{
+		if (!appendLeg(mNodeTiles[node]))
+		{
+			path.clear();
+			return FLT_MAX;
+		}
+	}
+
+	if (!appendLeg(mDestinationTile[nodes.back()]))
+	{
+		path.clear();
+		return FLT_MAX;
+	}
+
+	float routeCost = 0.0f;
+	for (std::size_t i = 1; i < path.size(); ++i)
+	{
+		routeCost += i + 1 == path.size() ? mGrid.endpointCost[path[i]] : mGrid.cost[path[i]];
+	}
+
+	return routeCost;
+}
+
+
+std::size_t SectorGraph::sectorIndex(std::size_t tileIndex) const
+{
+	const auto width = static_cast<std::size_t>(mGrid.size.x);
+	const auto x = tileIndex % width;
+	const auto y = tileIndex / width;
+	return (y / SectorSize) * static_cast<std::size_t>(mSizeInSectors.x) + x / SectorSize;
+}
+
+
+NAS2D::Rectangle<int> SectorGraph::sectorBounds(std::size_t sectorIndex) const
+{
+	const auto x = static_cast<int>(sectorIndex % static_cast<std::size_t>(mSizeInSectors.x)) * SectorSize;
+	const auto y = static_cast<int>(sectorIndex / static_cast<std::size_t>(mSizeInSectors.x)) * SectorSize;
+	return {x, y, std::min(SectorSize, mGrid.size.x - x), std::min(SectorSize, mGrid.size.y - y)};
+}
+
+
+/**
+ * Places the entrances along a sector's east and south edges.
+ */
+void SectorGraph::buildEntrances(std::size_t sectorIndex)
+{
+	auto& sector = mSectors[sectorIndex];
+	const auto bounds = sectorBounds(sectorIndex);
+	const auto width = static_cast<std::size_t>(mGrid.size.x);
+
+	sector.eastEntrances.clear();
+	if (bounds.x + bounds.width < mGrid.size.x)
+	{
+		const auto first = static_cast<std::size_t>(bounds.y) * width + static_cast<std::size_t>(bounds.x + bounds.width - 1);
+		placeEntrances(mGrid, first, width, static_cast<std::size_t>(bounds.height), 1, sector.eastEntrances);
+	}
+
+	sector.southEntrances.clear();
+	if (bounds.y + bounds.height < mGrid.size.y)
+	{
+		const auto first = static_cast<std::size_t>(bounds.y + bounds.height - 1) * width + static_cast<std::size_t>(bounds.x);
+		placeEntrances(mGrid, first, 1, static_cast<std::size_t>(bounds.width), width, sector.southEntrances);
+	}
+}
+
+
+/**
+ * Gathers the entrances on all four edges of a sector and finds the cost
+ * between each pair of them without leaving the sector.
+ */
+void SectorGraph::buildNodes(std::size_t sectorIndex, GridPathfinder& pathfinder)
+{
+	auto& sector = mSectors[sectorIndex];
+	const auto sectorsWide = static_cast<std::size_t>(mSizeInSectors.x);
+	const auto width = static_cast<std::size_t>(mGrid.size.x);
+
+	auto& nodes = sector.nodes;
+	nodes = sector.eastEntrances;
+	nodes.insert(nodes.end(), sector.southEntrances.begin(), sector.southEntrances.end());
+
+	if (sectorIndex % sectorsWide > 0)
+	{
+		for (auto tile : mSectors[sectorIndex - 1].eastEntrances) { nodes.push_back(tile + 1); }
+	}
+
+	if (sectorIndex >= sectorsWide)
+	{
+		for (auto tile : mSectors[sectorIndex - sectorsWide].southEntrances) { nodes.push_back(tile + width); }
+	}
+
+	std::sort(nodes.begin(), nodes.end());
+	nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+	const auto bounds = sectorBounds(sectorIndex);
+	const auto nodeCount = nodes.size();
+	sector.costs.assign(nodeCount * nodeCount, FLT_MAX);
+	for (std::size_t from = 0; from < nodeCount; ++from)
+	{
+		pathfinder.searchWithin(mGrid, nodes[from], bounds);
+		for (std::size_t to = 0; to < nodeCount; ++to)
+		{
+			sector.costs[from * nodeCount + to] = pathfinder.settledCost(nodes[to]);
+		}
+	}
+}
+
+
+/**
+ * Gets the graph node of an entrance tile, or NoTile if the tile isn't an
+ * entrance.
+ */
+std::size_t SectorGraph::nodeId(std::size_t tileIndex) const
+{
+	const auto& sector = mSectors[sectorIndex(tileIndex)];
+	const auto it = std::lower_bound(sector.nodes.begin(), sector.nodes.end(), tileIndex);
+	if (it == sector.nodes.end() || *it != tileIndex) { return NoTile; }
+	return sector.firstNode + static_cast<std::size_t>(it - sector.nodes.begin());
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "GridPathfinder.h"
+
+#include <map>
+#include <vector>
+
+
+class TileMap;
+
+
+/**
+ * Hierarchical abstraction of the surface for finding long routes.
+ *
+ * The surface is split into square sectors. Each open stretch of the edge
+ * between two neighboring sectors gets an entrance at its cheapest crossing.
+ * Entrance tiles are the nodes of a small abstract graph, and the cost of
+ * the cheapest path between every pair of nodes in a sector is computed
+ * ahead of time. A route search runs over the abstract graph first and
+ * then searches tile by tile only within the sectors the route crosses.
+ *
+ * Keeps its own RouteCostGrid in step with the map through update(). Only
+ * sectors touched by a change, and the neighbors sharing an edge with
+ * them, are rebuilt by the next refresh().
+ *
+ * \note	Routes found this way can cost slightly more than the cheapest
+ *			route. findRoute() only reads the graph, so several threads can
+ *			call it at once as long as each uses its own GridPathfinder.
+ */
+class SectorGraph
+{
+public:
+	static constexpr int SectorSize = 16; /**< Edge length of a sector in tiles. */
+
+	void reset(const TileMap& tileMap);
+	void update(const TileMap& tileMap, const std::vector<std::size_t>& changedTiles);
+	void refresh(GridPathfinder& pathfinder);
+
+	void destinations(GridPathfinder& pathfinder, const GridPathfinder::Path& destinations);
+	float findRoute(GridPathfinder& pathfinder, std::size_t start, GridPathfinder::Path& path) const;
+
+	const RouteCostGrid& costGrid() const { return mGrid; }
+
+private:
+	struct Sector
+	{
+		std::vector<std::size_t> eastEntrances; /**< Tiles on this sector's side of the east edge. */
+		std::vector<std::size_t> southEntrances; /**< Tiles on this sector's side of the south edge. */
+
+		std::vector<std::size_t> nodes; /**< Entrance tiles on every edge, sorted. */
+		std::vector<float> costs; /**< Cost between nodes, costs[from * nodes.size() + to]. */
+		std::size_t firstNode = 0; /**< Graph id of nodes.front(). */
+
+		bool dirty = true;
+	};
+
+	std::size_t sectorIndex(std::size_t tileIndex) const;
+	NAS2D::Rectangle<int> sectorBounds(std::size_t sectorIndex) const;
+
+	void buildEntrances(std::size_t sectorIndex);
+	void buildNodes(std::size_t sectorIndex, GridPathfinder& pathfinder);
+	std::size_t nodeId(std::size_t tileIndex) const;
+
+	RouteCostGrid mGrid;
+	NAS2D::Vector<int> mSizeInSectors;
+
+	std::vector<Sector> mSectors;
+	std::vector<std::size_t> mNodeTiles; /**< Tile of each graph node. */
+
+	std::map<std::size_t, GridPathfinder::Path> mDestinations; /**< Destination tiles by sector. */
+	std::vector<float> mDestinationCost; /**< Cost from each graph node to the nearest destination in its sector. */
+	std::vector<std::size_t> mDestinationTile; /**< That destination. */
+};
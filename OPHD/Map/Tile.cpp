@@ -1,6 +1,5 @@
 #include "Tile.h"
 
-#include "../Mine.h"
 #include "../Things/Robots/Robot.h"
 #include "../Things/Structures/Structure.h"
 
@@ -47,39 +46,66 @@ const NAS2D::Color& overlayHighlightColor(Tile::Overlay overlay)
 }
 
 
+/**
+ * Signal raised whenever a tile's terrain or occupying Thing changes.
+ *
+ * \note	Shared by all tiles. Tiles don't know which TileMap owns them so
+ *			the owning TileMap listens here and filters by position.
+ */
+Tile::ChangeSignal& Tile::changed()
+{
+	static ChangeSignal signal;
+	return signal;
+}
+
+
+Tile::Tile() :
+	mExcavated{true},
+	mConnected{false},
+	mHasMine{false}
+{}
+
+
 Tile::Tile(NAS2D::Point<int> position, int depth, TerrainType index) :
+	mX{static_cast<std::uint16_t>(position.x)},
+	mY{static_cast<std::uint16_t>(position.y)},
+	mDepth{static_cast<std::uint8_t>(depth)},
 	mIndex{index},
-	mPosition{position},
-	mDepth{depth}
+	mExcavated{true},
+	mConnected{false},
+	mHasMine{false}
 {}
 
 
 Tile::Tile(Tile&& other) noexcept :
-	mIndex{other.mIndex},
-	mPosition{other.mPosition},
-	mDepth{other.mDepth},
 	mThing{other.mThing},
-	mMine{other.mMine},
+	mX{other.mX},
+	mY{other.mY},
+	mDepth{other.mDepth},
+	mIndex{other.mIndex},
 	mOverlay{other.mOverlay},
-	mExcavated{other.mExcavated}
+	mExcavated{other.mExcavated},
+	mConnected{false},
+	mHasMine{other.mHasMine}
 {
 	other.mThing = nullptr;
-	other.mMine = nullptr;
+	other.mHasMine = false;
 }
 
 
 Tile& Tile::operator=(Tile&& other) noexcept
 {
-	mIndex = other.mIndex;
-	mPosition = other.mPosition;
-	mDepth = other.mDepth;
 	mThing = other.mThing;
-	mMine = other.mMine;
+	mX = other.mX;
+	mY = other.mY;
+	mDepth = other.mDepth;
+	mIndex = other.mIndex;
 	mOverlay = other.mOverlay;
 	mExcavated = other.mExcavated;
+	mHasMine = other.mHasMine;
 
 	other.mThing = nullptr;
-	other.mMine = nullptr;
+	other.mHasMine = false;
 
 	return *this;
 }
@@ -87,7 +113,6 @@ Tile& Tile::operator=(Tile&& other) noexcept
 
 Tile::~Tile()
 {
-	delete mMine;
 	delete mThing;
 }
 
@@ -105,6 +130,7 @@ void Tile::pushThing(Thing* thing)
 	}
 
 	mThing = thing;
+	changed()(*this);
 }
 
 
@@ -128,13 +154,7 @@ void Tile::deleteThing()
 void Tile::removeThing()
 {
 	mThing = nullptr;
-}
-
-
-void Tile::pushMine(Mine* _mine)
-{
-	delete mMine;
-	mMine = _mine;
+	changed()(*this);
 }
 
 
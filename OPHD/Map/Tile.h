@@ -3,10 +3,12 @@
 #include "../Common.h"
 
 #include <NAS2D/Renderer/Point.h>
+#include <NAS2D/Signal.h>
 #include <NAS2D/Renderer/Vector.h>
 
+#include <cstdint>
+
 
-class Mine;
 class Thing;
 class Robot;
 class Structure;
@@ -15,7 +17,7 @@ class Structure;
 class Tile
 {
 public:
-	enum class Overlay
+	enum class Overlay : std::uint8_t
 	{
 		Communications,
 		Connectedness,
@@ -24,8 +26,12 @@ public:
 		None
 	};
 
+	using ChangeSignal = NAS2D::Signals::Signal<const Tile&>;
+
 public:
-	Tile() = default;
+	static ChangeSignal& changed();
+
+	Tile();
 	Tile(NAS2D::Point<int>, int, TerrainType);
 	Tile(const Tile&) = delete;
 	Tile& operator=(const Tile&) = delete;
@@ -34,12 +40,12 @@ public:
 	~Tile();
 
 	TerrainType index() const { return mIndex; }
-	void index(TerrainType index) { mIndex = index; }
+	void index(TerrainType index) { mIndex = index; changed()(*this); }
 
-	NAS2D::Point<int> position() const { return mPosition; }
+	NAS2D::Point<int> position() const { return {mX, mY}; }
 
 	int depth() const { return mDepth; }
-	void depth(int i) { mDepth = i; }
+	void depth(int i) { mDepth = static_cast<std::uint8_t>(i); }
 
 	bool bulldozed() const { return index() == TerrainType::Dozed; }
 
@@ -53,7 +59,8 @@ public:
 
 	bool empty() const { return mThing == nullptr; }
 
-	bool hasMine() const { return mMine != nullptr; }
+	bool hasMine() const { return mHasMine; }
+	void hasMine(bool value) { mHasMine = value; }
 
 	Structure* structure() const;
 	Robot* robot() const;
@@ -66,25 +73,22 @@ public:
 
 	void removeThing();
 
-	Mine* mine() { return mMine; }
-	void pushMine(Mine*);
-
 	void overlay(Overlay overlay) { mOverlay = overlay; }
 	Overlay overlay() const { return mOverlay; }
 
 private:
-	TerrainType mIndex = TerrainType::Dozed;
-
-	NAS2D::Point<int> mPosition; /**< Tile Position Information */
-	int mDepth = 0; /**< Tile Position Information */
-
 	Thing* mThing = nullptr;
-	Mine* mMine = nullptr;
 
+	std::uint16_t mX = 0; /**< Tile Position Information */
+	std::uint16_t mY = 0; /**< Tile Position Information */
+	std::uint8_t mDepth = 0; /**< Tile Position Information */
+
+	TerrainType mIndex = TerrainType::Dozed;
 	Overlay mOverlay{ Overlay::None };
 
-	bool mExcavated = true; /**< Used when a Digger uncovers underground tiles. */
-	bool mConnected = false; /**< Flag indicating that this tile is connected to the Command Center. */
+	bool mExcavated : 1; /**< Used when a Digger uncovers underground tiles. */
+	bool mConnected : 1; /**< Flag indicating that this tile is connected to the Command Center. */
+	bool mHasMine : 1; /**< Mine data lives in TileMap, keyed by tile index. */
 };
 
 const NAS2D::Color& overlayColor(Tile::Overlay, bool);
@@ -9,6 +9,9 @@
 #include <NAS2D/Filesystem.h>
 #include <NAS2D/Xml/XmlElement.h>
 
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
 #include <algorithm>
 #include <functional>
 #include <random>
@@ -21,9 +24,6 @@ using namespace NAS2D::Xml;
 
 const std::string MAP_TERRAIN_EXTENSION = "_a.png";
 
-const int MAP_WIDTH = 300;
-const int MAP_HEIGHT = 150;
-
 const int TILE_WIDTH = 128;
 const int TILE_HEIGHT = 64;
 
@@ -44,8 +44,9 @@ const std::map<Planet::Hostility, std::array<int, 3>> HostilityMineYieldTable =
 };
 
 
-TileMap::TileMap(const std::string& mapPath, const std::string& tilesetPath, int maxDepth, int mineCount, Planet::Hostility hostility, bool shouldSetupMines) :
-	mSizeInTiles{MAP_WIDTH, MAP_HEIGHT},
+TileMap::TileMap(const std::string& mapPath, const std::string& tilesetPath, NAS2D::Vector<int> sizeInTiles, int maxDepth, int mineCount, Planet::Hostility hostility, bool shouldSetupMines) :
+	mSizeInTiles{sizeInTiles},
+	mSizeInChunks{(sizeInTiles.x + ChunkSize - 1) / ChunkSize, (sizeInTiles.y + ChunkSize - 1) / ChunkSize},
 	mMaxDepth(maxDepth),
 	mMapPath(mapPath),
 	mTsetPath(tilesetPath),
@@ -59,6 +60,14 @@ TileMap::TileMap(const std::string& mapPath, const std::string& tilesetPath, int
 
 	if (shouldSetupMines) { setupMines(mineCount, hostility); }
 	std::cout << "finished!" << std::endl;
+
+	Tile::changed().connect(this, &TileMap::onTileChanged);
+}
+
+
+TileMap::~TileMap()
+{
+	Tile::changed().disconnect(this, &TileMap::onTileChanged);
 }
 
 
@@ -71,7 +80,35 @@ TileMap::TileMap(const std::string& mapPath, const std::string& tilesetPath, int
 void TileMap::removeMineLocation(const NAS2D::Point<int>& pt)
 {
 	mMineLocations.erase(find(mMineLocations.begin(), mMineLocations.end(), pt));
-	getTile(pt, 0).pushMine(nullptr);
+	pushMine(pt, nullptr);
+}
+
+
+/**
+ * Gets the Mine at a given location.
+ *
+ * \return	Pointer to a Mine or nullptr if there is no mine at the location.
+ */
+Mine* TileMap::mine(NAS2D::Point<int> position, int level)
+{
+	const auto it = mMines.find(tileIndex(position, level));
+	return it != mMines.end() ? it->second.get() : nullptr;
+}
+
+
+/**
+ * Places a Mine on a surface tile, replacing and freeing any Mine
+ * already there. Passing nullptr removes the Mine.
+ */
+void TileMap::pushMine(NAS2D::Point<int> position, Mine* mine)
+{
+	auto& tile = getTile(position, 0);
+	const auto index = tileIndex(position, 0);
+
+	if (mine) { mMines[index].reset(mine); }
+	else { mMines.erase(index); }
+
+	tile.hasMine(mine != nullptr);
 }
 
 
@@ -87,55 +124,202 @@ Tile& TileMap::getTile(NAS2D::Point<int> position, int level)
 	{
 		throw std::runtime_error("Tile coordinates out of bounds: {" + std::to_string(position.x) + ", " + std::to_string(position.y) + ", " + std::to_string(level) + "}");
 	}
-	const auto mapPosition = position.to<std::size_t>();
-	return mTileMap[static_cast<std::size_t>(level)][mapPosition.y][mapPosition.x];
+	return getTileUnchecked(position, level);
+}
+
+
+Tile& TileMap::getTileUnchecked(NAS2D::Point<int> position, int level)
+{
+	return chunk(position, level)[localTileIndex(position)];
 }
 
 
 /**
- * Builds the terrain map.
+ * Gets a surface tile from its tileIndex().
+ *
+ * \warning	Does no bounds checking.
  */
-void TileMap::buildTerrainMap(const std::string& path)
+Tile& TileMap::surfaceTile(std::size_t index)
 {
-	if (!Utility<Filesystem>::get().exists(path + MAP_TERRAIN_EXTENSION))
-	{
-		throw std::runtime_error("Given map file does not exist.");
-	}
+	const auto width = static_cast<std::size_t>(mSizeInTiles.x);
+	return getTileUnchecked({static_cast<int>(index % width), static_cast<int>(index / width)}, 0);
+}
 
-	const Image heightmap(path + MAP_TERRAIN_EXTENSION);
 
-	const auto levelCount = static_cast<std::size_t>(mMaxDepth) + 1;
-	mTileMap.resize(levelCount);
-	for(std::size_t level = 0; level < levelCount; level++)
+/**
+ * Gets a tile without allocating its chunk.
+ *
+ * \return	Pointer to the Tile or nullptr if the tile has never been
+ *			touched. Untouched tiles are unexcavated below the surface and
+ *			have the height map terrain on the surface.
+ *
+ * \note	Does no bounds checking.
+ */
+const Tile* TileMap::findTile(NAS2D::Point<int> position, int level) const
+{
+	const auto& tileChunk = mTileMap[chunkIndex(position, level)];
+	return tileChunk ? &(*tileChunk)[localTileIndex(position)] : nullptr;
+}
+
+
+/**
+ * Gets the terrain type of a tile without allocating its chunk.
+ *
+ * \note	Does no bounds checking.
+ */
+TerrainType TileMap::terrain(NAS2D::Point<int> position, int level) const
+{
+	const auto* tile = findTile(position, level);
+	return tile ? tile->index() : mTerrain[static_cast<std::size_t>(position.y * mSizeInTiles.x + position.x)];
+}
+
+
+/**
+ * Gets whether a tile has been excavated without allocating its chunk.
+ *
+ * \note	Does no bounds checking.
+ */
+bool TileMap::excavated(NAS2D::Point<int> position, int level) const
+{
+	const auto* tile = findTile(position, level);
+	return tile ? tile->excavated() : level == 0;
+}
+
+
+/**
+ * Gets the index of a tile within the flat, level-major tile array.
+ *
+ * \note	Does no bounds checking. Use isValidPosition() first if the
+ *			position is not known to be on the map.
+ */
+std::size_t TileMap::tileIndex(NAS2D::Point<int> position, int level) const
+{
+	const auto width = static_cast<std::size_t>(mSizeInTiles.x);
+	const auto height = static_cast<std::size_t>(mSizeInTiles.y);
+	return (static_cast<std::size_t>(level) * height + static_cast<std::size_t>(position.y)) * width + static_cast<std::size_t>(position.x);
+}
+
+
+/**
+ * Gets the chunk containing a given tile, allocating it if it hasn't
+ * been touched yet.
+ */
+TileMap::TileChunk& TileMap::chunk(NAS2D::Point<int> position, int level)
+{
+	auto& chunkSlot = mTileMap[chunkIndex(position, level)];
+	if (!chunkSlot) { chunkSlot = buildChunk({position.x >> ChunkShift, position.y >> ChunkShift}, level); }
+	return *chunkSlot;
+}
+
+
+std::size_t TileMap::chunkIndex(NAS2D::Point<int> position, int level) const
+{
+	const auto chunkX = static_cast<std::size_t>(position.x >> ChunkShift);
+	const auto chunkY = static_cast<std::size_t>(position.y >> ChunkShift);
+	return (static_cast<std::size_t>(level) * static_cast<std::size_t>(mSizeInChunks.y) + chunkY) * static_cast<std::size_t>(mSizeInChunks.x) + chunkX;
+}
+
+
+/**
+ * Creates a chunk of tiles seeded from the surface terrain.
+ *
+ * \note	Tiles in edge chunks that fall outside of the map are given
+ *			impassable terrain and are never handed out by getTile().
+ */
+std::unique_ptr<TileMap::TileChunk> TileMap::buildChunk(NAS2D::Point<int> chunkPosition, int level) const
+{
+	auto newChunk = std::make_unique<TileChunk>();
+	const auto origin = NAS2D::Point{chunkPosition.x << ChunkShift, chunkPosition.y << ChunkShift};
+
+	std::size_t index = 0;
+	for (int y = 0; y < ChunkSize; ++y)
 	{
-		mTileMap[level].resize(static_cast<std::size_t>(mSizeInTiles.y));
-		for (std::size_t i = 0; i < mTileMap[level].size(); i++)
+		for (int x = 0; x < ChunkSize; ++x, ++index)
 		{
-			mTileMap[level][i].resize(static_cast<std::size_t>(mSizeInTiles.x));
+			const auto position = origin + NAS2D::Vector{x, y};
+			const auto terrain = isValidPosition(position) ? mTerrain[static_cast<std::size_t>(position.y * mSizeInTiles.x + position.x)] : TerrainType::Impassable;
+
+			auto& tile = (*newChunk)[index];
+			tile = {position, level, terrain};
+			if (level > 0) { tile.excavated(false); }
 		}
 	}
 
-	/**
-	 * Builds a terrain map based on the pixel color values in
-	 * a maps height map.
-	 * 
-	 * Height maps by default are in grey-scale. This method assumes
-	 * that all channels are the same value so it only looks at the red.
-	 * Color values are divided by 50 to get a height value from 1 - 4.
-	 */
-	for(int depth = 0; depth <= mMaxDepth; depth++)
+	return newChunk;
+}
+
+
+/**
+ * Decodes a height map into a grid of terrain types.
+ *
+ * Height maps by default are in grey-scale. This method assumes
+ * that all channels are the same value so it only looks at the red.
+ * Color values are divided by 50 to get a height value from 1 - 4.
+ *
+ * The image is decoded in one go and converted to a known byte order
+ * so each row can be converted with a simple strided loop instead of
+ * fetching every pixel through NAS2D::Image::pixelColor().
+ */
+static std::vector<TerrainType> decodeHeightMap(const std::string& path, NAS2D::Vector<int> size)
+{
+	const auto file = Utility<Filesystem>::get().open(path);
+
+	SDL_Surface* image = IMG_Load_RW(SDL_RWFromConstMem(file.raw_bytes(), static_cast<int>(file.size())), 1);
+	if (!image)
+	{
+		throw std::runtime_error("Unable to decode height map '" + path + "': " + IMG_GetError());
+	}
+
+	SDL_Surface* surface = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0);
+	SDL_FreeSurface(image);
+	if (!surface)
+	{
+		throw std::runtime_error("Unable to convert height map '" + path + "': " + SDL_GetError());
+	}
+
+	if (surface->w != size.x || surface->h != size.y)
+	{
+		SDL_FreeSurface(surface);
+		throw std::runtime_error("Height map dimensions do not match the map size.");
+	}
+
+	const auto width = static_cast<std::size_t>(size.x);
+	std::vector<TerrainType> terrain(width * static_cast<std::size_t>(size.y));
+
+	const auto* pixels = static_cast<const std::uint8_t*>(surface->pixels);
+	for (std::size_t row = 0; row < static_cast<std::size_t>(size.y); ++row)
 	{
-		for(int row = 0; row < mSizeInTiles.y; row++)
+		// SDL_PIXELFORMAT_RGBA32 is byte ordered R, G, B, A on every platform.
+		const auto* red = pixels + row * static_cast<std::size_t>(surface->pitch);
+		auto* terrainRow = terrain.data() + row * width;
+		for (std::size_t col = 0; col < width; ++col)
 		{
-			for(int col = 0; col < mSizeInTiles.x; col++)
-			{
-				auto color = heightmap.pixelColor({col, row});
-				auto& tile = getTile({col, row}, depth);
-				tile = {{col, row}, depth, static_cast<TerrainType>(color.red / 50)};
-				if (depth > 0) { tile.excavated(false); }
-			}
+			terrainRow[col] = static_cast<TerrainType>(red[col * 4] / 50);
 		}
 	}
+
+	SDL_FreeSurface(surface);
+	return terrain;
+}
+
+
+/**
+ * Builds the terrain map.
+ *
+ * Only the terrain is decoded here. Tiles are created a chunk at
+ * a time as they're first needed.
+ */
+void TileMap::buildTerrainMap(const std::string& path)
+{
+	if (!Utility<Filesystem>::get().exists(path + MAP_TERRAIN_EXTENSION))
+	{
+		throw std::runtime_error("Given map file does not exist.");
+	}
+
+	mTerrain = decodeHeightMap(path + MAP_TERRAIN_EXTENSION, mSizeInTiles);
+
+	const auto levelCount = static_cast<std::size_t>(mMaxDepth) + 1;
+	mTileMap.resize(levelCount * static_cast<std::size_t>(mSizeInChunks.x) * static_cast<std::size_t>(mSizeInChunks.y));
 }
 
 
@@ -158,8 +342,8 @@ void TileMap::setupMines(int mineCount, Planet::Hostility hostility)
 
 	std::random_device rd;
 	std::mt19937 generator(rd());
-	std::uniform_int_distribution<int> distributionWidth(5, MAP_WIDTH - 5);
-	std::uniform_int_distribution<int> distributionHeight(5, MAP_HEIGHT - 5);
+	std::uniform_int_distribution<int> distributionWidth(5, mSizeInTiles.x - 5);
+	std::uniform_int_distribution<int> distributionHeight(5, mSizeInTiles.y - 5);
 
 	auto mwidth = std::bind(distributionWidth, std::ref(generator));
 	auto mheight = std::bind(distributionHeight, std::ref(generator));
@@ -183,9 +367,8 @@ void TileMap::addMineSet(NAS2D::Point<int> suggestedMineLocation, Point2dList& p
 	// If mines are right next to each other, then overwrite the old location with the new mine parameters
 	const auto mineLocation = findSurroundingMineLocation(suggestedMineLocation);
 
-	auto& tile = getTile(mineLocation, 0);
-	tile.pushMine(new Mine(rate));
-	tile.index(TerrainType::Dozed);
+	pushMine(mineLocation, new Mine(rate));
+	getTile(mineLocation, 0).index(TerrainType::Dozed);
 
 	plist.push_back(mineLocation);
 }
@@ -304,18 +487,25 @@ void TileMap::draw()
 	{
 		for (int col = 0; col < mEdgeLength; col++)
 		{
-			auto& tile = getTile(mMapViewLocation + NAS2D::Vector{col, row}, mCurrentDepth);
+			// Untouched tiles are drawn straight from the terrain grid so that
+			// scrolling around doesn't allocate chunks.
+			const auto tilePosition = mMapViewLocation + NAS2D::Vector{col, row};
+			const auto* tile = findTile(tilePosition, mCurrentDepth);
 
-			if (tile.excavated())
+			if (tile ? tile->excavated() : mCurrentDepth == 0)
 			{
 				const auto position = mMapPosition + NAS2D::Vector{(col - row) * TILE_HALF_WIDTH, (col + row) * TILE_HEIGHT_HALF_ABSOLUTE};
-				const auto subImageRect = NAS2D::Rectangle{static_cast<int>(tile.index()) * TILE_WIDTH, tsetOffset, TILE_WIDTH, TILE_HEIGHT};
+				const auto terrainType = tile ? tile->index() : terrain(tilePosition, mCurrentDepth);
+				const auto tileOverlay = tile ? tile->overlay() : Tile::Overlay::None;
+				const auto subImageRect = NAS2D::Rectangle{static_cast<int>(terrainType) * TILE_WIDTH, tsetOffset, TILE_WIDTH, TILE_HEIGHT};
 				const bool isTileHighlighted = NAS2D::Vector{col, row} == highlightOffset;
 
-				renderer.drawSubImage(mTileset, position, subImageRect, overlayColor(tile.overlay(), isTileHighlighted));
+				renderer.drawSubImage(mTileset, position, subImageRect, overlayColor(tileOverlay, isTileHighlighted));
+
+				if (!tile) { continue; }
 
 				// Draw a beacon on an unoccupied tile with a mine
-				if (tile.mine() != nullptr && !tile.thing())
+				if (tile->hasMine() && !tile->thing())
 				{
 					uint8_t glow = static_cast<uint8_t>(120 + sin(mTimer.tick() / THROB_SPEED) * 57);
 					const auto mineBeaconPosition = position + NAS2D::Vector{ 0, -64 };
@@ -325,7 +515,7 @@ void TileMap::draw()
 				}
 
 				// Tell an occupying thing to update itself.
-				if (tile.thing()) { tile.thing()->sprite().update(position); }
+				if (tile->thing()) { tile->thing()->sprite().update(position); }
 			}
 		}
 	}
@@ -415,6 +605,8 @@ void TileMap::serialize(NAS2D::Xml::XmlElement* element, const Planet::Attribute
 	properties->attribute("sitemap", planetAttributes.mapImagePath);
 	properties->attribute("tset", planetAttributes.tilesetPath);
 	properties->attribute("diggingdepth", planetAttributes.maxDepth);
+	properties->attribute("width", mSizeInTiles.x);
+	properties->attribute("height", mSizeInTiles.y);
 	// NAS2D only supports double for floating point conversions as of 26July2020
 	properties->attribute("meansolardistance", static_cast<double>(planetAttributes.meanSolarDistance));
 	// ==========================================
@@ -435,11 +627,11 @@ void TileMap::serialize(NAS2D::Xml::XmlElement* element, const Planet::Attribute
 
 	for (std::size_t i = 0; i < mMineLocations.size(); ++i)
 	{
-		XmlElement *mine = new XmlElement("mine");
-		mine->attribute("x", mMineLocations[i].x);
-		mine->attribute("y", mMineLocations[i].y);
-		getTile(mMineLocations[i], TileMapLevel::LEVEL_SURFACE).mine()->serialize(mine);
-		mines->linkEndChild(mine);
+		XmlElement *mineElement = new XmlElement("mine");
+		mineElement->attribute("x", mMineLocations[i].x);
+		mineElement->attribute("y", mMineLocations[i].y);
+		mine(mMineLocations[i], TileMapLevel::LEVEL_SURFACE)->serialize(mineElement);
+		mines->linkEndChild(mineElement);
 	}
 
 
@@ -450,22 +642,25 @@ void TileMap::serialize(NAS2D::Xml::XmlElement* element, const Planet::Attribute
 	element->linkEndChild(tiles);
 
 	// We're only writing out tiles that don't have structures or robots in them that are
-	// underground and excavated or surface and bulldozed.
-	for (int depth = 0; depth <= maxDepth(); ++depth)
+	// underground and excavated or surface and bulldozed. Chunks that were never touched
+	// can't contain either so they're skipped entirely.
+	for (const auto& tileChunk : mTileMap)
 	{
-		for (int y = 0; y < mSizeInTiles.y; ++y)
+		if (!tileChunk) { continue; }
+
+		for (const auto& tile : *tileChunk)
 		{
-			for (int x = 0; x < mSizeInTiles.x; ++x)
+			const auto position = tile.position();
+			const auto depth = tile.depth();
+			if (!isValidPosition(position, depth)) { continue; }
+
+			if (depth > 0 && tile.excavated() && tile.empty() && !tile.hasMine())
 			{
-				auto& tile = getTile({x, y}, depth);
-				if (depth > 0 && tile.excavated() && tile.empty() && tile.mine() == nullptr)
-				{
-					serializeTile(tiles, x, y, depth, tile.index());
-				}
-				else if (tile.index() == TerrainType::Dozed && tile.empty() && tile.mine() == nullptr)
-				{
-					serializeTile(tiles, x, y, depth, tile.index());
-				}
+				serializeTile(tiles, position.x, position.y, depth, tile.index());
+			}
+			else if (tile.index() == TerrainType::Dozed && tile.empty() && !tile.hasMine())
+			{
+				serializeTile(tiles, position.x, position.y, depth, tile.index());
 			}
 		}
 	}
@@ -503,9 +698,8 @@ void TileMap::deserialize(NAS2D::Xml::XmlElement* element)
 		Mine* mine = new Mine();
 		mine->deserialize(mineElement->toElement());
 
-		auto& tile = getTile({x, y}, 0);
-		tile.pushMine(mine);
-		tile.index(TerrainType::Dozed);
+		pushMine({x, y}, mine);
+		getTile({x, y}, 0).index(TerrainType::Dozed);
 
 		mMineLocations.push_back(Point{x, y});
 
@@ -565,63 +759,78 @@ bool TileMap::isVisibleTile(NAS2D::Point<int> position, int z) const
 
 
 /**
- * Implements MicroPather interface.
- * 
- * \warning	Assumes stateStart and stateEnd are never nullptr.
+ * Cost for a truck to move onto a surface tile.
+ *
+ * \param	position	Surface tile position. Not bounds checked.
+ * \param	isEndpoint	True if the tile is the start or end of the route. Endpoints
+ *						are occupied by the mine and smelter but must still be enterable.
+ *
+ * \return	Movement cost or FLT_MAX if the tile can't be traveled through.
  */
-float TileMap::LeastCostEstimate(void* stateStart, void* stateEnd)
+float TileMap::routeCost(NAS2D::Point<int> position, bool isEndpoint) const
 {
-	return sqrtf(static_cast<float>((static_cast<Tile*>(stateEnd)->position() - static_cast<Tile*>(stateStart)->position()).lengthSquared()));
+	const auto* tile = findTile(position, 0);
+	const auto terrainType = tile ? tile->index() : terrain(position, 0);
+
+	if (terrainType == TerrainType::Impassable) { return FLT_MAX; }
+
+	const float terrainCost = constants::ROUTE_BASE_COST * (static_cast<float>(terrainType) + 1.0f);
+	if (!tile || tile->empty() || isEndpoint) { return terrainCost; }
+
+	if (tile->thingIsStructure() && tile->structure()->structureId() == StructureID::SID_ROAD) { return 0.5f; }
+
+	return FLT_MAX;
 }
 
 
-void TileMap::AdjacentCost(void* state, std::vector<micropather::StateCost>* adjacent)
+/**
+ * Builds a snapshot of routeCost() for every surface tile.
+ *
+ * \note	The snapshot doesn't follow later changes to the map. Build a new
+ *			one for each round of route searches.
+ */
+RouteCostGrid TileMap::routeCostGrid() const
 {
-	auto& tile = *static_cast<Tile*>(state);
-	const auto tilePosition = tile.position();
+	RouteCostGrid grid;
+	grid.size = mSizeInTiles;
 
-	for (const auto& offset : DirectionClockwise4)
+	const auto tileCount = static_cast<std::size_t>(mSizeInTiles.x) * static_cast<std::size_t>(mSizeInTiles.y);
+	grid.cost.reserve(tileCount);
+	grid.endpointCost.reserve(tileCount);
+
+	for (int y = 0; y < mSizeInTiles.y; ++y)
 	{
-		const auto position = tilePosition + offset;
-		if (!NAS2D::Rectangle{0, 0, mSizeInTiles.x, mSizeInTiles.y}.contains(position))
+		for (int x = 0; x < mSizeInTiles.x; ++x)
 		{
-			continue;
+			const float cost = routeCost({x, y}, false);
+			const float endpointCost = routeCost({x, y}, true);
+			grid.cost.push_back(cost);
+			grid.endpointCost.push_back(endpointCost);
+			grid.minimumCost = std::min({grid.minimumCost, cost, endpointCost});
 		}
+	}
 
-		auto& adjacentTile = getTile(position, 0);
-		float cost = constants::ROUTE_BASE_COST;
+	return grid;
+}
 
-		if (adjacentTile.index() == TerrainType::Impassable)
-		{
-			cost = FLT_MAX;
-		}
-		else if (!adjacentTile.empty())
-		{
-			if (&adjacentTile == mPathStartEndPair.first || &adjacentTile == mPathStartEndPair.second)
-			{
-				cost *= static_cast<float>(adjacentTile.index()) + 1.0f;
-			}
-			else if (adjacentTile.thingIsStructure() && adjacentTile.structure()->structureId() == StructureID::SID_ROAD)
-			{
-				cost = 0.5f;
-			}
-			else
-			{
-				cost = FLT_MAX;
-			}
-		}
-		else
-		{
-			cost *= static_cast<float>(adjacentTile.index()) + 1.0f;
-		}
 
-		micropather::StateCost nodeCost = { &adjacentTile, cost };
-		adjacent->push_back(nodeCost);
-	}
+/**
+ * Gets the indexes of every surface tile whose terrain or occupant has changed
+ * since the last call and clears the list.
+ *
+ * \note	May contain duplicates.
+ */
+std::vector<std::size_t> TileMap::takeChangedSurfaceTiles()
+{
+	std::vector<std::size_t> changedTiles;
+	changedTiles.swap(mChangedSurfaceTiles);
+	return changedTiles;
 }
 
 
-void TileMap::pathStartAndEnd(void* start, void* end)
+void TileMap::onTileChanged(const Tile& tile)
 {
-	mPathStartEndPair = std::make_pair(start, end);
+	if (tile.depth() != 0) { return; }
+	mChangedSurfaceTiles.push_back(tileIndex(tile.position(), 0));
 }
+
@@ -1,14 +1,17 @@
 #pragma once
 
 #include "Tile.h"
+#include "GridPathfinder.h"
 
 #include "../States/Planet.h"
-#include "../MicroPather/micropather.h"
 
 #include <NAS2D/Renderer/Point.h>
 #include <NAS2D/Renderer/Vector.h>
 
 #include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
 
 
 namespace NAS2D {
@@ -18,10 +21,13 @@ namespace NAS2D {
 }
 
 
+class Mine;
+
+
 using Point2dList = std::vector<NAS2D::Point<int>>;
 
 
-class TileMap: public micropather::Graph
+class TileMap
 {
 public:
 	enum TileMapLevel
@@ -34,15 +40,34 @@ public:
 	};
 
 
-	TileMap(const std::string& mapPath, const std::string& tilesetPath, int maxDepth, int mineCount, Planet::Hostility hostility /*= constants::Hostility::None*/, bool setupMines = true);
+	TileMap(const std::string& mapPath, const std::string& tilesetPath, NAS2D::Vector<int> sizeInTiles, int maxDepth, int mineCount, Planet::Hostility hostility /*= constants::Hostility::None*/, bool setupMines = true);
 	TileMap(const TileMap&) = delete;
 	TileMap& operator=(const TileMap&) = delete;
+	~TileMap();
 
 	bool isValidPosition(NAS2D::Point<int> position, int level = 0) const;
 
 	Tile& getTile(NAS2D::Point<int> position, int level);
 	Tile& getTile(NAS2D::Point<int> position) { return getTile(position, mCurrentDepth); }
 
+	std::size_t tileIndex(NAS2D::Point<int> position, int level) const;
+
+	/** \warning Does no bounds checking. Intended for internal loops that have already validated coordinates. */
+	Tile& getTileUnchecked(NAS2D::Point<int> position, int level);
+	Tile& surfaceTile(std::size_t index);
+
+	/** Read-only queries. These never allocate tiles for untouched parts of the map. */
+	const Tile* findTile(NAS2D::Point<int> position, int level) const;
+	TerrainType terrain(NAS2D::Point<int> position, int level) const;
+	bool excavated(NAS2D::Point<int> position, int level) const;
+
+	const std::vector<TerrainType>& terrainGrid() const { return mTerrain; }
+
+	float routeCost(NAS2D::Point<int> position, bool isEndpoint) const;
+	RouteCostGrid routeCostGrid() const;
+
+	std::vector<std::size_t> takeChangedSurfaceTiles();
+
 	Tile* getVisibleTile(NAS2D::Point<int> position, int level);
 	Tile* getVisibleTile() { return getVisibleTile(tileMouseHover(), mCurrentDepth); }
 
@@ -62,6 +87,9 @@ public:
 	const Point2dList& mineLocations() const { return mMineLocations; }
 	void removeMineLocation(const NAS2D::Point<int>& pt);
 
+	Mine* mine(NAS2D::Point<int> position, int level = 0);
+	Mine* mine(const Tile& tile) { return mine(tile.position(), tile.depth()); }
+
 	int edgeLength() const { return mEdgeLength; }
 	NAS2D::Vector<int> size() const { return mSizeInTiles; }
 
@@ -79,14 +107,6 @@ public:
 	void serialize(NAS2D::Xml::XmlElement* element, const Planet::Attributes& planetAttributes);
 	void deserialize(NAS2D::Xml::XmlElement* element);
 
-
-	/** MicroPather public interface implementation. */
-	float LeastCostEstimate(void* stateStart, void* stateEnd) override;
-	void AdjacentCost(void* state, std::vector<micropather::StateCost>* adjacent) override;
-	void PrintStateInfo(void* /*state*/) override {}
-
-	void pathStartAndEnd(void* start, void* end);
-
 protected:
 	enum MouseMapRegion
 	{
@@ -100,8 +120,17 @@ protected:
 	std::vector<std::vector<MouseMapRegion> > mMouseMap;
 
 private:
-	using TileGrid = std::vector<std::vector<Tile> >;
-	using TileArray = std::vector<TileGrid>;
+	static constexpr int ChunkShift = 5;
+	static constexpr int ChunkSize = 1 << ChunkShift; /**< Edge length of a chunk in tiles. */
+
+	using TileChunk = std::array<Tile, ChunkSize * ChunkSize>;
+	using TileChunkArray = std::vector<std::unique_ptr<TileChunk>>;
+
+	static std::size_t localTileIndex(NAS2D::Point<int> position) { return static_cast<std::size_t>(((position.y & (ChunkSize - 1)) << ChunkShift) | (position.x & (ChunkSize - 1))); }
+
+	std::size_t chunkIndex(NAS2D::Point<int> position, int level) const;
+	TileChunk& chunk(NAS2D::Point<int> position, int level);
+	std::unique_ptr<TileChunk> buildChunk(NAS2D::Point<int> chunkPosition, int level) const;
 
 	void buildMouseMap();
 	void buildTerrainMap(const std::string& path);
@@ -109,6 +138,10 @@ private:
 	void addMineSet(NAS2D::Point<int> suggestedMineLocation, Point2dList& plist, MineProductionRate rate);
 	NAS2D::Point<int> findSurroundingMineLocation(NAS2D::Point<int> centerPoint);
 
+	void pushMine(NAS2D::Point<int> position, Mine* mine);
+
+	void onTileChanged(const Tile& tile);
+
 	void updateTileHighlight();
 
 	MouseMapRegion getMouseMapRegion(int x, int y);
@@ -116,16 +149,18 @@ private:
 
 	int mEdgeLength = 0;
 	const NAS2D::Vector<int> mSizeInTiles;
+	const NAS2D::Vector<int> mSizeInChunks;
 
 	int mMaxDepth = 0; /**< Maximum digging depth. */
 	int mCurrentDepth = 0; /**< Current depth level to view. */
 
-	std::pair<void*, void*> mPathStartEndPair = { nullptr, nullptr };
-
 	std::string mMapPath;
 	std::string mTsetPath;
 
-	TileArray mTileMap;
+	std::vector<TerrainType> mTerrain; /**< Surface terrain decoded from the height map. Shared by all untouched chunks. */
+	TileChunkArray mTileMap; /**< Chunks stored level-major. Chunks are allocated the first time a tile in them is requested for writing. */
+	std::vector<std::size_t> mChangedSurfaceTiles; /**< Surface tiles changed since the last call to takeChangedSurfaceTiles(). */
+	std::map<std::size_t, std::unique_ptr<Mine>> mMines; /**< Mines keyed by tile index. Few tiles have one so they're kept out of Tile. */
 
 	const NAS2D::Image mTileset;
 	const NAS2D::Image mMineBeacon;
@@ -2,12 +2,13 @@
 
 #include "Common.h"
 #include "Constants.h"
+#include "SessionArena.h"
 
 #include <NAS2D/Xml/XmlElement.h>
 
 #include <bitset>
 
-class Mine
+class Mine : public SessionObject
 {
 public:
 	enum OreType
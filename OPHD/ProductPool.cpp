@@ -114,6 +114,16 @@ int storageRequiredPerUnit(ProductType type)
 }
 
 
+/**
+ * Signal raised whenever the contents of any ProductPool change.
+ */
+ProductPool::ChangeSignal& ProductPool::changed()
+{
+	static ChangeSignal signal;
+	return signal;
+}
+
+
 int ProductPool::capacity() const
 {
 	return mCapacity;
@@ -162,6 +172,29 @@ void ProductPool::transferAllTo(ProductPool& destination)
 }
 
 
+/**
+ * Removes the products that transferAllTo() would move into a pool with
+ * the given amount of available storage.
+ *
+ * \note	Used to test a transfer without making a copy of the destination.
+ */
+void ProductPool::transferAllTo(int destinationAvailableStorage)
+{
+	if (empty() || destinationAvailableStorage <= 0) { return; }
+
+	for (std::size_t i = 0; i < ProductType::PRODUCT_COUNT; ++i)
+	{
+		if (destinationAvailableStorage == 0) { return; }
+
+		const auto productType = static_cast<ProductType>(i);
+		const bool canTransferAll = (destinationAvailableStorage >= storageRequired(productType, mProducts[i]));
+		const int unitsToMove = canTransferAll ? mProducts[i] : destinationAvailableStorage / storageRequiredPerUnit(productType);
+		destinationAvailableStorage -= storageRequired(productType, unitsToMove);
+		pull(productType, unitsToMove);
+	}
+}
+
+
 /**
  * Stores a specified amount of a ProductType.
  * 
@@ -179,6 +212,7 @@ void ProductPool::store(ProductType type, int count)
 	}
 
 	mCurrentStorageCount = computeCurrentStorage(mProducts);
+	changed()(*this);
 }
 
 
@@ -187,6 +221,7 @@ int ProductPool::pull(ProductType type, int c)
 	int pulledCount = std::clamp(c, 0, mProducts[static_cast<std::size_t>(type)]);
 	mProducts[static_cast<std::size_t>(type)] -= pulledCount;
 	mCurrentStorageCount = computeCurrentStorage(mProducts);
+	changed()(*this);
 
 	return pulledCount;
 }
@@ -201,6 +236,7 @@ int ProductPool::count(ProductType type)
 void ProductPool::verifyCount()
 {
 	mCurrentStorageCount = computeCurrentStorage(mProducts);
+	changed()(*this);
 }
 
 
@@ -237,4 +273,5 @@ void ProductPool::deserialize(NAS2D::Xml::XmlElement* element)
 		attribute = attribute->next();
 	}
 	mCurrentStorageCount = computeCurrentStorage(mProducts);
+	changed()(*this);
 }
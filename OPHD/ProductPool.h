@@ -3,6 +3,7 @@
 #include "Common.h"
 #include "Constants.h"
 
+#include <NAS2D/Signal.h>
 #include <NAS2D/Xml/XmlElement.h>
 
 #include <array>
@@ -14,7 +15,9 @@ class ProductPool
 {
 public:
 	using ProductTypeCount = std::array<int, ProductType::PRODUCT_COUNT>;
+	using ChangeSignal = NAS2D::Signals::Signal<const ProductPool&>;
 
+	static ChangeSignal& changed();
 
 	ProductPool() = default;
 	~ProductPool() = default;
@@ -29,6 +32,7 @@ public:
 	bool atCapacity() const;
 
 	void transferAllTo(ProductPool& destination);
+	void transferAllTo(int destinationAvailableStorage);
 	void store(ProductType type, int count);
 	int pull(ProductType type, int count);
 	int count(ProductType type);
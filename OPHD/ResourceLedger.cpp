@@ -0,0 +1,128 @@
+#include "ResourceLedger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+/**
+ * Adds a storage structure to the ledger. Anything it already holds is
+ * added to the totals.
+ *
+ * \note	The Command Center is always first in fill order.
+ */
+void ResourceLedger::addTank(Structure* tank)
+{
+	if (tank->structureClass() == Structure::StructureClass::Command)
+	{
+		mTanks.insert(mTanks.begin(), tank);
+	}
+	else
+	{
+		mTanks.push_back(tank);
+	}
+
+	mTotal += tank->storage();
+	mCapacity += StorableResources{ tankCapacity(tank), tankCapacity(tank), tankCapacity(tank), tankCapacity(tank) };
+}
+
+
+/**
+ * Removes a storage structure from the ledger. Whatever the structure
+ * holds is removed from the totals along with it.
+ */
+void ResourceLedger::removeTank(Structure* tank)
+{
+	auto it = std::find(mTanks.begin(), mTanks.end(), tank);
+	if (it == mTanks.end())
+	{
+		throw std::runtime_error("ResourceLedger::removeTank(): Structure is not a tracked storage tank.");
+	}
+
+	distribute();
+
+	mTotal -= tank->storage();
+	mCapacity -= StorableResources{ tankCapacity(tank), tankCapacity(tank), tankCapacity(tank), tankCapacity(tank) };
+	mTanks.erase(it);
+}
+
+
+void ResourceLedger::clear()
+{
+	mTanks.clear();
+	mTotal = {};
+	mCapacity = {};
+	mDistributed = true;
+}
+
+
+/**
+ * Adds refined resources to storage.
+ *
+ * \note	Anything that doesn't fit is left in \c resources.
+ */
+void ResourceLedger::deposit(StorableResources& resources)
+{
+	for (std::size_t i = 0; i < resources.resources.size(); ++i)
+	{
+		const int space = std::max(mCapacity.resources[i] - mTotal.resources[i], 0);
+		const int stored = std::clamp(resources.resources[i], 0, space);
+		mTotal.resources[i] += stored;
+		resources.resources[i] -= stored;
+	}
+
+	mDistributed = false;
+}
+
+
+/**
+ * Removes refined resources from storage.
+ *
+ * \note	Anything that wasn't available is left in \c resources.
+ */
+void ResourceLedger::withdraw(StorableResources& resources)
+{
+	for (std::size_t i = 0; i < resources.resources.size(); ++i)
+	{
+		const int pulled = std::clamp(resources.resources[i], 0, mTotal.resources[i]);
+		mTotal.resources[i] -= pulled;
+		resources.resources[i] -= pulled;
+	}
+
+	mDistributed = false;
+}
+
+
+/**
+ * Writes the totals out to the individual tanks, filling each tank in
+ * order before moving to the next.
+ */
+void ResourceLedger::distribute()
+{
+	if (mDistributed) { return; }
+
+	auto remaining = mTotal;
+	for (auto tank : mTanks)
+	{
+		auto& stored = tank->storage();
+		stored = remaining.cap(tankCapacity(tank));
+		remaining -= stored;
+	}
+
+	mDistributed = true;
+}
+
+
+/**
+ * Rebuilds the totals from tank contents. Used after tank contents have
+ * been set directly, e.g., when loading a saved game.
+ */
+void ResourceLedger::recount()
+{
+	mTotal = {};
+	for (auto tank : mTanks)
+	{
+		mTotal += tank->storage();
+	}
+
+	mDistributed = true;
+}
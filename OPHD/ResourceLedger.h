@@ -0,0 +1,39 @@
+#pragma once
+
+#include "StorableResources.h"
+#include "Things/Structures/Structure.h"
+
+
+/**
+ * Keeps the colony's refined resources held in the Command Center and
+ * storage tanks.
+ *
+ * Deposits and withdrawals only change the aggregate totals. Contents of
+ * individual tanks are written out when they're actually needed (saving,
+ * or a tank being removed) by filling tanks in order, Command Center
+ * first, the same order deposits have always used.
+ */
+class ResourceLedger
+{
+public:
+	void addTank(Structure* tank);
+	void removeTank(Structure* tank);
+	void clear();
+
+	const StorableResources& total() const { return mTotal; }
+	const StorableResources& capacity() const { return mCapacity; }
+
+	void deposit(StorableResources& resources);
+	void withdraw(StorableResources& resources);
+
+	void distribute();
+	void recount();
+
+private:
+	static int tankCapacity(const Structure* tank) { return tank->storageCapacity() / 4; }
+
+	StructureList mTanks; /**< Command Center followed by storage tanks, in fill order. */
+	StorableResources mTotal; /**< Refined resources held across all tanks. */
+	StorableResources mCapacity; /**< Amount of each refined resource all tanks can hold. */
+	bool mDistributed = true; /**< Tank contents match mTotal. */
+};
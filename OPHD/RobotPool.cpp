@@ -3,6 +3,7 @@
 #include "Map/Tile.h"
 
 #include <algorithm>
+#include <stdexcept>
 
 
 int ROBOT_ID_COUNTER = 0; /// \fixme Kludge
@@ -29,19 +30,49 @@ void RobotPool::clear()
 	clearRobots(mDozers);
 	clearRobots(mMiners);
 	mRobots.clear();
+	mRobotsById.clear();
 
 	mRobotControlCount = 0;
 	mRobotControlMax = 0;
 }
 
 
+/**
+ * Removes a robot from the pool without freeing it.
+ *
+ * \note	The last robot of each list takes the removed robot's place.
+ */
 void RobotPool::erase(Robot* robot)
 {
-	mRobots.erase(find(mRobots.begin(), mRobots.end(), robot));
+	if (robot->mRobotsIndex >= mRobots.size() || mRobots[robot->mRobotsIndex] != robot)
+	{
+		throw std::runtime_error("RobotPool::erase(): Attempting to erase a Robot that is not in the pool.");
+	}
+
+	switch (robot->type())
+	{
+	case Robot::Type::Digger:
+		removeFromList(mDiggers, robot);
+		break;
+
+	case Robot::Type::Dozer:
+		removeFromList(mDozers, robot);
+		break;
+
+	case Robot::Type::Miner:
+		removeFromList(mMiners, robot);
+		break;
+
+	default:
+		break;
+	}
+
+	auto* last = mRobots.back();
+	mRobots[robot->mRobotsIndex] = last;
+	last->mRobotsIndex = robot->mRobotsIndex;
+	mRobots.pop_back();
 
-	eraseRobot(mDiggers, robot);
-	eraseRobot(mDozers, robot);
-	eraseRobot(mMiners, robot);
+	mRobotsById.erase(robot->id());
 }
 
 
@@ -57,31 +88,47 @@ Robot* RobotPool::addRobot(Robot::Type type, int id /*= 0*/)
 	if (id == 0) { _id = ++ROBOT_ID_COUNTER; }
 	else { _id = id; }
 
+	Robot* robot = nullptr;
+
 	switch (type)
 	{
 	case Robot::Type::Dozer:
-		mDozers.push_back(new Robodozer());
-		mDozers.back()->id(_id);
-		mRobots.push_back(mDozers.back());
-		return mDozers.back();
+		robot = new Robodozer();
+		insertIntoList(mDozers, robot);
+		break;
 
 	case Robot::Type::Digger:
-		mDiggers.push_back(new Robodigger());
-		mDiggers.back()->id(_id);
-		mRobots.push_back(mDiggers.back());
-		return mDiggers.back();
+		robot = new Robodigger();
+		insertIntoList(mDiggers, robot);
+		break;
 
 	case Robot::Type::Miner:
-		mMiners.push_back(new Robominer());
-		mMiners.back()->id(_id);
-		mRobots.push_back(mMiners.back());
-		return mMiners.back();
+		robot = new Robominer();
+		insertIntoList(mMiners, robot);
+		break;
 
 	default:
-		break;
+		return nullptr;
 	}
 
-	return nullptr;
+	robot->id(_id);
+	robot->mRobotsIndex = mRobots.size();
+	mRobots.push_back(robot);
+	mRobotsById[_id] = robot;
+
+	return robot;
+}
+
+
+/**
+ * Finds a robot by its ID.
+ *
+ * \return	Returns a pointer to the robot or nullptr if no robot has the ID.
+ */
+Robot* RobotPool::findRobot(int id) const
+{
+	const auto it = mRobotsById.find(id);
+	return it != mRobotsById.end() ? it->second : nullptr;
 }
 
 
@@ -186,14 +233,11 @@ void RobotPool::AddRobotCtrl()
 }
 
 
-bool RobotPool::insertRobotIntoTable(RobotTileTable& robotMap, Robot* robot, Tile* tile)
+bool RobotPool::insertRobotIntoTable(RobotTaskTable& robotTasks, Robot* robot, Tile* tile)
 {
 	if (!tile) { return false; }
 
-	auto it = robotMap.find(robot);
-	if (it != robotMap.end()) { throw std::runtime_error("MapViewState::insertRobot(): Attempting to add a duplicate Robot* pointer."); }
-
-	robotMap[robot] = tile;
+	robotTasks.insert(robot, tile);
 	tile->pushThing(robot);
 
 	AddRobotCtrl();
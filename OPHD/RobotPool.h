@@ -1,8 +1,11 @@
 #pragma once
 
 
+#include "RobotTaskTable.h"
 #include "Things/Robots/Robots.h"
 
+#include <unordered_map>
+
 
 class Tile;
 
@@ -13,13 +16,13 @@ public:
 	using DiggerList = std::vector<Robodigger*>;
 	using DozerList = std::vector<Robodozer*>;
 	using MinerList = std::vector<Robominer*>;
-	using RobotTileTable = std::map<Robot*, Tile*>;
 
 public:
 	RobotPool();
 	~RobotPool();
 
 	Robot* addRobot(Robot::Type type, int id = 0);
+	Robot* findRobot(int id) const;
 
 	Robodigger* getDigger();
 	Robodozer* getDozer();
@@ -39,7 +42,7 @@ public:
 
 	void clear();
 	void erase(Robot* robot);
-	bool insertRobotIntoTable(RobotTileTable& robotMap, Robot* robot, Tile* tile);
+	bool insertRobotIntoTable(RobotTaskTable& robotTasks, Robot* robot, Tile* tile);
 
 	uint32_t robotControlMax() { return mRobotControlMax; }
 	uint32_t currentControlCount() { return mRobotControlCount; }
@@ -48,11 +51,28 @@ public:
 	const RobotList& robots() const { return mRobots; }
 
 private:
+	template <class T>
+	static void insertIntoList(T& list, Robot* robot)
+	{
+		robot->mPoolIndex = list.size();
+		list.push_back(static_cast<typename T::value_type>(robot));
+	}
+
+	template <class T>
+	static void removeFromList(T& list, Robot* robot)
+	{
+		auto last = list.back();
+		list[robot->mPoolIndex] = last;
+		last->mPoolIndex = robot->mPoolIndex;
+		list.pop_back();
+	}
+
 	DiggerList mDiggers;
 	DozerList mDozers;
 	MinerList mMiners;
 
 	RobotList mRobots; // List of all robots by pointer to base class
+	std::unordered_map<int, Robot*> mRobotsById;
 
 	uint32_t mRobotControlMax = 0;
 	uint32_t mRobotControlCount = 0;
@@ -52,13 +52,3 @@ void updateRobotControlCount(const T& t, uint32_t& controlCounter)
 	}
 }
 
-
-template <class T>
-void eraseRobot(T& t, Robot* robot)
-{
-	auto it = find(t.begin(), t.end(), robot);
-	if (it != t.end())
-	{
-		t.erase(it);
-	}
-}
@@ -0,0 +1,91 @@
+#include "RobotTaskTable.h"
+
+#include <stdexcept>
+
+
+/**
+ * Adds a task for a deployed robot.
+ *
+ * \note	A robot can only be part of one task at a time. A robot added to
+ *			a tile that already has one becomes the tile's robot, the same
+ *			way Tile::pushThing() replaces the tile's Thing.
+ */
+void RobotTaskTable::insert(Robot* robot, Tile* tile)
+{
+	if (contains(robot))
+	{
+		throw std::runtime_error("RobotTaskTable::insert(): Attempting to add a duplicate Robot* pointer.");
+	}
+
+	robot->mTaskIndex = mTasks.size();
+	mTaskByTile[tile] = mTasks.size();
+	mTasks.push_back({ robot, tile, robot->type() });
+}
+
+
+/**
+ * Removes a robot's task. Does nothing if the robot isn't deployed.
+ *
+ * \note	The last task in the list takes the removed task's place.
+ */
+void RobotTaskTable::erase(Robot* robot)
+{
+	if (!contains(robot)) { return; }
+
+	const auto index = robot->mTaskIndex;
+	const auto tileIt = mTaskByTile.find(mTasks[index].tile);
+	if (tileIt != mTaskByTile.end() && tileIt->second == index)
+	{
+		mTaskByTile.erase(tileIt);
+	}
+
+	if (index != mTasks.size() - 1)
+	{
+		mTasks[index] = mTasks.back();
+		mTasks[index].robot->mTaskIndex = index;
+
+		const auto movedIt = mTaskByTile.find(mTasks[index].tile);
+		if (movedIt != mTaskByTile.end() && movedIt->second == mTasks.size() - 1)
+		{
+			movedIt->second = index;
+		}
+	}
+
+	mTasks.pop_back();
+}
+
+
+void RobotTaskTable::clear()
+{
+	mTasks.clear();
+	mTaskByTile.clear();
+}
+
+
+bool RobotTaskTable::contains(const Robot* robot) const
+{
+	return robot->mTaskIndex < mTasks.size() && mTasks[robot->mTaskIndex].robot == robot;
+}
+
+
+/**
+ * Gets the tile a robot is working on.
+ *
+ * \return	Returns nullptr if the robot isn't deployed.
+ */
+Tile* RobotTaskTable::tile(const Robot* robot) const
+{
+	return contains(robot) ? mTasks[robot->mTaskIndex].tile : nullptr;
+}
+
+
+/**
+ * Gets the robot working on a tile.
+ *
+ * \return	Returns nullptr if no robot is deployed on the tile.
+ */
+Robot* RobotTaskTable::robotOn(const Tile& tile) const
+{
+	const auto it = mTaskByTile.find(&tile);
+	return it != mTaskByTile.end() ? mTasks[it->second].robot : nullptr;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Things/Robots/Robot.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+
+class Tile;
+
+
+/**
+ * Robots deployed on the map, the tile each one is working on and the
+ * kind of task it's performing.
+ *
+ * Tasks are kept in one contiguous list. Removing a task moves the last
+ * task into its place so order is not preserved.
+ */
+class RobotTaskTable
+{
+public:
+	struct Task
+	{
+		Robot* robot = nullptr;
+		Tile* tile = nullptr;
+		Robot::Type kind = Robot::Type::None;
+	};
+
+	using TaskList = std::vector<Task>;
+
+public:
+	void insert(Robot* robot, Tile* tile);
+	void erase(Robot* robot);
+	void clear();
+
+	bool contains(const Robot* robot) const;
+	Tile* tile(const Robot* robot) const;
+	Robot* robotOn(const Tile& tile) const;
+
+	const Task& operator[](std::size_t index) const { return mTasks[index]; }
+	std::size_t size() const { return mTasks.size(); }
+	bool empty() const { return mTasks.empty(); }
+
+	TaskList::const_iterator begin() const { return mTasks.begin(); }
+	TaskList::const_iterator end() const { return mTasks.end(); }
+
+private:
+	TaskList mTasks;
+	std::unordered_map<const Tile*, std::size_t> mTaskByTile; /**< Reverse index, tile to its slot in mTasks. */
+};
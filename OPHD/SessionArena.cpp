@@ -0,0 +1,129 @@
+#include "SessionArena.h"
+
+#include <NAS2D/Utility.h>
+
+#include <algorithm>
+#include <functional>
+#include <new>
+
+
+SessionArena::~SessionArena()
+{
+	freeBlocks(mBlocks);
+	freeBlocks(mRetiredBlocks);
+}
+
+
+void* SessionArena::allocate(std::size_t size)
+{
+	if (size > MaxSlotSize)
+	{
+		return ::operator new(size);
+	}
+
+	const auto slot = slotClass(size);
+	if (slot >= mFreeSlots.size())
+	{
+		mFreeSlots.resize(slot + 1);
+	}
+
+	++mLiveCount;
+
+	auto& freeSlots = mFreeSlots[slot];
+	if (!freeSlots.empty())
+	{
+		void* pointer = freeSlots.back();
+		freeSlots.pop_back();
+		return pointer;
+	}
+
+	const auto slotSize = slot * SlotAlignment;
+	if (mBlockUsed + slotSize > BlockSize)
+	{
+		mBlocks.push_back(::operator new(BlockSize));
+		mBlockUsed = 0;
+	}
+
+	void* pointer = static_cast<char*>(mBlocks.back()) + mBlockUsed;
+	mBlockUsed += slotSize;
+	return pointer;
+}
+
+
+void SessionArena::deallocate(void* pointer, std::size_t size)
+{
+	if (pointer == nullptr) { return; }
+
+	if (size > MaxSlotSize)
+	{
+		::operator delete(pointer);
+		return;
+	}
+
+	if (!mRetiredBlocks.empty() && retired(pointer))
+	{
+		if (--mRetiredLiveCount == 0) { freeBlocks(mRetiredBlocks); }
+		return;
+	}
+
+	mFreeSlots[slotClass(size)].push_back(pointer);
+	--mLiveCount;
+}
+
+
+/**
+ * Ends the current session's allocations and frees all of its blocks.
+ *
+ * \note	Owners are expected to have destroyed their objects first. If
+ *			any are still alive their blocks are retired instead: nothing
+ *			more is allocated from them and they're freed once the last of
+ *			those objects is deallocated.
+ */
+void SessionArena::release()
+{
+	if (mLiveCount > 0)
+	{
+		mRetiredBlocks.insert(mRetiredBlocks.end(), mBlocks.begin(), mBlocks.end());
+		mRetiredLiveCount += mLiveCount;
+		mBlocks.clear();
+		mLiveCount = 0;
+	}
+
+	freeBlocks(mBlocks);
+	mFreeSlots.clear();
+	mBlockUsed = BlockSize;
+}
+
+
+bool SessionArena::retired(const void* pointer) const
+{
+	const auto* address = static_cast<const char*>(pointer);
+	return std::any_of(mRetiredBlocks.begin(), mRetiredBlocks.end(), [address](const void* block)
+	{
+		const auto* begin = static_cast<const char*>(block);
+		return !std::less<const char*>{}(address, begin) && std::less<const char*>{}(address, begin + BlockSize);
+	});
+}
+
+
+void SessionArena::freeBlocks(std::vector<void*>& blocks)
+{
+	for (auto block : blocks)
+	{
+		::operator delete(block);
+	}
+
+	blocks.clear();
+}
+
+
+void* SessionObject::operator new(std::size_t size)
+{
+	return NAS2D::Utility<SessionArena>::get().allocate(size);
+}
+
+
+void SessionObject::operator delete(void* pointer, std::size_t size)
+{
+	NAS2D::Utility<SessionArena>::get().deallocate(pointer, size);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+/**
+ * Allocator for objects that live for one game session.
+ *
+ * Memory comes from large blocks carved into fixed size slots, one free
+ * list per slot size, so objects of the same type end up packed together
+ * and freeing one is a push onto its free list. Blocks are released
+ * together once the session is over: release() frees them right away if
+ * nothing is left alive. Otherwise they're retired, the next session
+ * starts on fresh blocks and the retired ones are freed together with the
+ * last object still in them.
+ *
+ * Structures, robots and mines are allocated from here through
+ * SessionObject. Objects still have their destructors run by whoever owns
+ * them: structures disconnect from signals and return their component
+ * handles, robots detach from their Robot Command Center, and mines and
+ * structures own heap storage of their own.
+ *
+ * \note	Not thread safe. Allocate and free from the main thread only.
+ */
+class SessionArena
+{
+public:
+	SessionArena() = default;
+	SessionArena(const SessionArena&) = delete;
+	SessionArena& operator=(const SessionArena&) = delete;
+	~SessionArena();
+
+	void* allocate(std::size_t size);
+	void deallocate(void* pointer, std::size_t size);
+
+	void release();
+
+	std::size_t liveCount() const { return mLiveCount; }
+
+private:
+	static constexpr std::size_t SlotAlignment = alignof(std::max_align_t);
+	static constexpr std::size_t BlockSize = 64 * 1024;
+	static constexpr std::size_t MaxSlotSize = 4 * 1024; /**< Larger objects use the global heap. */
+
+	static std::size_t slotClass(std::size_t size) { return (size + SlotAlignment - 1) / SlotAlignment; }
+
+	bool retired(const void* pointer) const;
+	static void freeBlocks(std::vector<void*>& blocks);
+
+	std::vector<std::vector<void*>> mFreeSlots; /**< Free slots indexed by slot class. */
+	std::vector<void*> mBlocks;
+	std::size_t mBlockUsed = BlockSize; /**< Bytes used in the newest block. */
+	std::size_t mLiveCount = 0;
+
+	std::vector<void*> mRetiredBlocks; /**< Blocks of released sessions that still hold live objects. */
+	std::size_t mRetiredLiveCount = 0;
+};
+
+
+/**
+ * Base for types allocated from the SessionArena. Derived types are still
+ * created with new and destroyed with delete by their owners.
+ */
+class SessionObject
+{
+public:
+	static void* operator new(std::size_t size);
+	static void operator delete(void* pointer, std::size_t size);
+};
@@ -5,8 +5,8 @@
 #include "../Constants.h"
 #include "../DirectionOffset.h"
 #include "../Cache.h"
-#include "../GraphWalker.h"
 #include "../StructureCatalogue.h"
+#include "../SessionArena.h"
 #include "../StructureManager.h"
 
 #include "../Map/Tile.h"
@@ -20,6 +20,7 @@
 #include <NAS2D/Renderer/Renderer.h>
 
 #include <algorithm>
+#include <chrono>
 #include <sstream>
 #include <vector>
 
@@ -30,7 +31,6 @@
 using namespace NAS2D;
 
 
-const std::string MAP_TERRAIN_EXTENSION = "_a.png";
 const std::string MAP_DISPLAY_EXTENSION = "_b.png";
 
 extern Point<int> MOUSE_COORDS;
@@ -69,43 +69,6 @@ const std::map<Robot::Type, RobotMeta> RobotMetaTable
 };
 
 
-static NAS2D::Rectangle<int> buildAreaRectFromTile(const Tile& centerTile, int commRange)
-{
-	const NAS2D::Point commAreaStartPoint
-	{
-		std::clamp(centerTile.position().x - commRange, 0, 299),
-		std::clamp(centerTile.position().y - commRange, 0, 149)
-	};
-
-	const NAS2D::Point commAreaEndPoint
-	{
-		std::clamp(centerTile.position().x + commRange, 0, 299),
-		std::clamp(centerTile.position().y + commRange, 0, 149)
-	};
-
-	return NAS2D::Rectangle<int>::Create(commAreaStartPoint, commAreaEndPoint);
-}
-
-
-static void fillCommList(TileList& tileList, TileMap& tileMap, Tile& centerTile, const NAS2D::Rectangle<int>& area, int commRange)
-{
-	for (int y = 0; y < area.height; ++y)
-	{
-		for (int x = 0; x < area.width; ++x)
-		{
-			auto& tile = tileMap.getTile({ x + area.x, y + area.y });
-			if (isPointInRange(centerTile.position(), tile.position(), commRange))
-			{
-				if (std::find(tileList.begin(), tileList.end(), &tile) == tileList.end())
-				{
-					tileList.push_back(&tile);
-				}
-			}
-		}
-	}
-}
-
-
 MapViewState::MapViewState(MainReportsUiState& mainReportsState, const std::string& savegame) :
 	mMainReportsState(mainReportsState),
 	mLoadingExisting(true),
@@ -118,22 +81,25 @@ MapViewState::MapViewState(MainReportsUiState& mainReportsState, const std::stri
 
 MapViewState::MapViewState(MainReportsUiState& mainReportsState, const Planet::Attributes& planetAttributes) :
 	mMainReportsState(mainReportsState),
-	mTileMap(new TileMap(planetAttributes.mapImagePath, planetAttributes.tilesetPath, planetAttributes.maxDepth, planetAttributes.maxMines, planetAttributes.hostility)),
+	mTileMap(new TileMap(planetAttributes.mapImagePath, planetAttributes.tilesetPath, {planetAttributes.mapWidth, planetAttributes.mapHeight}, planetAttributes.maxDepth, planetAttributes.maxMines, planetAttributes.hostility)),
 	mPlanetAttributes(planetAttributes),
 	mMapDisplay{std::make_unique<Image>(planetAttributes.mapImagePath + MAP_DISPLAY_EXTENSION)},
-	mHeightMap{std::make_unique<Image>(planetAttributes.mapImagePath + MAP_TERRAIN_EXTENSION)}
+	mHeightMap{buildHeightMapImage(*mTileMap)}
 {
 	ccLocation() = CcNotPlaced;
+	Utility<StructureManager>::get().commRangeGrid().reset(mTileMap->size());
 	Utility<EventHandler>::get().windowResized().connect(this, &MapViewState::onWindowResized);
 }
 
 
 MapViewState::~MapViewState()
 {
-	delete mPathSolver;
-
 	scrubRobotList();
+	mRobotList.clear();
+	mRobotPool.clear();
+	Utility<StructureManager>::get().dropAllStructures();
 	delete mTileMap;
+	Utility<SessionArena>::get().release();
 
 	Utility<Renderer>::get().setCursor(PointerType::POINTER_NORMAL);
 
@@ -203,8 +169,7 @@ void MapViewState::initialize()
 
 	MAIN_FONT = &fontCache.load(constants::FONT_PRIMARY, constants::FONT_PRIMARY_NORMAL);
 
-	delete mPathSolver;
-	mPathSolver = new micropather::MicroPather(mTileMap);
+	mSectorGraph.reset(*mTileMap);
 }
 
 
@@ -287,16 +252,11 @@ int MapViewState::totalStorage(Structure::StructureClass structureClass, int cap
 		storageCapacity += constants::BASE_STORAGE_CAPACITY;
 	}
 
-	const auto& structures = Utility<StructureManager>::get().structureList(structureClass);
-	for (auto structure : structures)
-	{
-		if (structure->operational() || structure->isIdle())
-		{
-			storageCapacity += capacity;
-		}
-	}
+	const auto& structureManager = Utility<StructureManager>::get();
+	const int structureCount = structureManager.getCountInState(structureClass, StructureState::Operational) +
+		structureManager.getCountInState(structureClass, StructureState::Idle);
 
-	return storageCapacity;
+	return storageCapacity + structureCount * capacity;
 }
 
 
@@ -313,16 +273,7 @@ int MapViewState::refinedResourcesInStorage()
 
 void MapViewState::countPlayerResources()
 {
-	auto storage = NAS2D::Utility<StructureManager>::get().structureList(Structure::StructureClass::Storage);
-	auto& command = NAS2D::Utility<StructureManager>::get().structureList(Structure::StructureClass::Command);
-	storage.insert(storage.begin(), command.begin(), command.end());
-
-	StorableResources resources;
-	for (auto structure : storage)
-	{
-		resources += structure->storage();
-	}
-	mResourcesCount = resources;
+	mResourcesCount = NAS2D::Utility<StructureManager>::get().resourceLedger().total();
 }
 
 
@@ -436,6 +387,13 @@ void MapViewState::onKeyDown(EventHandler::KeyCode key, EventHandler::KeyModifie
 			changeViewDepth(mTileMap->maxDepth());
 			break;
 
+		case EventHandler::KeyCode::KEY_F9:
+			if (Utility<EventHandler>::get().control(mod) && Utility<EventHandler>::get().shift(mod))
+			{
+				printUpdateTimes();
+			}
+			break;
+
 		case EventHandler::KeyCode::KEY_F10:
 			if (Utility<EventHandler>::get().control(mod) && Utility<EventHandler>::get().shift(mod))
 			{
@@ -508,13 +466,13 @@ void MapViewState::onMouseDown(EventHandler::MouseButton button, int /*x*/, int
 		if (tile.empty() && mTileMap->boundingBox().contains(MOUSE_COORDS))
 		{
 			clearSelections();
-			mTileInspector.tile(&tile);
+			mTileInspector.tile(&tile, mTileMap);
 			mTileInspector.show();
 			mWindowStack.bringToFront(&mTileInspector);
 		}
-		else if (tile.thingIsRobot())
+		else if (auto* robot = mRobotList.robotOn(tile))
 		{
-			mRobotInspector.focusOnRobot(tile.robot());
+			mRobotInspector.focusOnRobot(robot);
 			mRobotInspector.show();
 			mWindowStack.bringToFront(&mRobotInspector);
 		}
@@ -754,7 +712,7 @@ void MapViewState::placeTubes()
 	if (!tile) { return; }
 
 	// Check the basics.
-	if (tile->thing() || tile->mine() || !tile->bulldozed() || !tile->excavated()) { return; }
+	if (tile->thing() || tile->hasMine() || !tile->bulldozed() || !tile->excavated()) { return; }
 
 	/** \fixme	This is a kludge that only works because all of the tube structures are listed alphabetically.
 	 *			Should instead take advantage of the updated meta data in the IconGridItem.
@@ -765,8 +723,6 @@ void MapViewState::placeTubes()
 	{
 		insertTube(cd, mTileMap->currentDepth(), &mTileMap->getTile(mTileMapMouseHover));
 
-		// FIXME: Naive approach -- will be slow with larger colonies.
-		Utility<StructureManager>::get().disconnectAll();
 		checkConnectedness();
 	}
 	else
@@ -783,7 +739,7 @@ void MapViewState::placeTubeStart()
 	if (!tile) { return; }
 
 	// Check the basics.
-	if (tile->thing() || tile->mine() || !tile->bulldozed() || !tile->excavated()) { return; }
+	if (tile->thing() || tile->hasMine() || !tile->bulldozed() || !tile->excavated()) { return; }
 
 	/** \fixme	This is a kludge that only works because all of the tube structures are listed alphabetically.
 	 *			Should instead take advantage of the updated meta data in the IconGridItem.
@@ -846,15 +802,13 @@ void MapViewState::placeTubeEnd()
 		tile = mTileMap->getVisibleTile(mTubeStart, mTileMap->currentDepth());
 		if (!tile) {
 			endReach = true;
-		}else if (tile->thing() || tile->mine() || !tile->bulldozed() || !tile->excavated()){
+		}else if (tile->thing() || tile->hasMine() || !tile->bulldozed() || !tile->excavated()){
 			endReach = true;
 		}else if (!validTubeConnection(mTileMap, position, cd)){
 			endReach = true;
 		}else{
 			insertTube(cd, mTileMap->currentDepth(), &mTileMap->getTile(position));
 
-			// FIXME: Naive approach -- will be slow with larger colonies.
-			Utility<StructureManager>::get().disconnectAll();
 			checkConnectedness();
 		}
 
@@ -877,17 +831,19 @@ void MapViewState::placeRobodozer(Tile& tile)
 		doAlertMessage(constants::ALERT_INVALID_ROBOT_PLACEMENT, constants::ALERT_TILE_BULLDOZED);
 		return;
 	}
-	else if (tile.mine())
+	else if (tile.hasMine())
 	{
-		if (tile.mine()->depth() != mTileMap->maxDepth() || !tile.mine()->exhausted())
+		const auto* mine = mTileMap->mine(tile);
+		if (mine->depth() != mTileMap->maxDepth() || !mine->exhausted())
 		{
 			doAlertMessage(constants::ALERT_INVALID_ROBOT_PLACEMENT, constants::ALERT_MINE_NOT_EXHAUSTED);
 			return;
 		}
 
 		mMineOperationsWindow.hide();
+		auto* mineFacility = mTileMap->getTile(mTileMap->tileMouseHover(), 0).structure();
+		if (mineFacility && mineFacility->isMineFacility()) { forgetMineRoute(static_cast<MineFacility*>(mineFacility)); }
 		mTileMap->removeMineLocation(mTileMap->tileMouseHover());
-		tile.pushMine(nullptr);
 		for (int i = 0; i <= mTileMap->maxDepth(); ++i)
 		{
 			auto& mineShaftTile = mTileMap->getTile(mTileMap->tileMouseHover(), i);
@@ -929,11 +885,6 @@ void MapViewState::placeRobodozer(Tile& tile)
 			else { return; }
 		}
 
-		if (structure->structureClass() == Structure::StructureClass::Communication)
-		{
-			checkCommRangeOverlay();
-		}
-
 		auto recycledResources = StructureCatalogue::recyclingValue(structure->structureId());
 		addRefinedResources(recycledResources);
 
@@ -945,12 +896,11 @@ void MapViewState::placeRobodozer(Tile& tile)
 		countPlayerResources();
 		updateStructuresAvailability();
 
-		tile.connected(false);
 		Utility<StructureManager>::get().removeStructure(structure);
 		tile.deleteThing();
-		Utility<StructureManager>::get().disconnectAll();
 		static_cast<Robodozer*>(robot)->tileIndex(static_cast<std::size_t>(TerrainType::Dozed));
 		checkConnectedness();
+		checkCommRangeOverlay();
 	}
 
 	int taskTime = tile.index() == TerrainType::Dozed ? 1 : static_cast<int>(tile.index());
@@ -1047,7 +997,7 @@ void MapViewState::placeRobominer(Tile& tile)
 {
 	if (tile.thing()) { doAlertMessage(constants::ALERT_INVALID_ROBOT_PLACEMENT, constants::ALERT_MINER_TILE_OBSTRUCTED); return; }
 	if (mTileMap->currentDepth() != constants::DEPTH_SURFACE) { doAlertMessage(constants::ALERT_INVALID_ROBOT_PLACEMENT, constants::ALERT_MINER_SURFACE_ONLY); return; }
-	if (!tile.mine()) { doAlertMessage(constants::ALERT_INVALID_ROBOT_PLACEMENT, constants::ALERT_MINER_NOT_ON_MINE); return; }
+	if (!tile.hasMine()) { doAlertMessage(constants::ALERT_INVALID_ROBOT_PLACEMENT, constants::ALERT_MINER_NOT_ON_MINE); return; }
 
 	Robot* robot = mRobotPool.getMiner();
 	robot->startTask(constants::MINER_TASK_TIME);
@@ -1070,7 +1020,7 @@ void MapViewState::placeRobot()
 	if (!tile->excavated()) { return; }
 	if (!mRobotPool.robotCtrlAvailable()) { return; }
 
-	if (!inCommRange(tile->position()))
+	if (!Utility<StructureManager>::get().commRangeGrid().covered(tile->position()))
 	{
 		doAlertMessage(constants::ALERT_INVALID_ROBOT_PLACEMENT, constants::ALERT_OUT_OF_COMM_RANGE);
 		return;
@@ -1124,7 +1074,7 @@ void MapViewState::placeStructure()
 		return;
 	}
 
-	if (tile->mine())
+	if (tile->hasMine())
 	{
 		doAlertMessage(constants::ALERT_INVALID_STRUCTURE_ACTION, constants::ALERT_STRUCTURE_MINE_IN_WAY);
 		return;
@@ -1264,11 +1214,13 @@ void MapViewState::insertSeedLander(NAS2D::Point<int> point)
  */
 void MapViewState::updateRobots()
 {
-	auto robot_it = mRobotList.begin();
-	while(robot_it != mRobotList.end())
+	// Removing a task moves the last task into its slot, so the index only
+	// advances past tasks that stay in the table.
+	std::size_t index = 0;
+	while (index < mRobotList.size())
 	{
-		auto robot = robot_it->first;
-		auto tile = robot_it->second;
+		auto robot = mRobotList[index].robot;
+		auto tile = mRobotList[index].tile;
 
 		robot->update();
 
@@ -1295,16 +1247,11 @@ void MapViewState::updateRobots()
 				tile->removeThing();
 			}
 
-			for (auto rcc : Utility<StructureManager>::get().structureList(Structure::StructureClass::RobotCommand))
-			{
-				static_cast<RobotCommand*>(rcc)->removeRobot(robot);
-			}
-
 			if (mRobotInspector.focusedRobot() == robot) { mRobotInspector.hide(); }
 
+			mRobotList.erase(robot);
 			mRobotPool.erase(robot);
 			delete robot;
-			robot_it = mRobotList.erase(robot_it);
 		}
 		else if (robot->idle())
 		{
@@ -1312,7 +1259,7 @@ void MapViewState::updateRobots()
 			{
 				tile->removeThing();
 			}
-			robot_it = mRobotList.erase(robot_it);
+			mRobotList.erase(robot);
 
 			if (robot->taskCanceled())
 			{
@@ -1323,7 +1270,7 @@ void MapViewState::updateRobots()
 		}
 		else
 		{
-			++robot_it;
+			++index;
 		}
 	}
 
@@ -1354,11 +1301,15 @@ void MapViewState::setStructureID(StructureID type, InsertMode mode)
 /**
  * Checks the connectedness of all tiles surrounding
  * the Command Center.
+ *
+ * \note	Only tiles that changed since the last check are looked at. Cheap
+ *			to call when nothing has changed.
  */
 void MapViewState::checkConnectedness()
 {
 	if (ccLocation() == CcNotPlaced)
 	{
+		mConnectivity.update(*mTileMap, nullptr);
 		return;
 	}
 
@@ -1371,42 +1322,44 @@ void MapViewState::checkConnectedness()
 		throw std::runtime_error("CC coordinates do not actually point to a Command Center.");
 	}
 
-	if (cc->state() == StructureState::UnderConstruction)
-	{
-		return;
-	}
-
-	tile.connected(true);
-
-	// Start graph walking at the CC location.
-	mConnectednessOverlay.clear();
-	GraphWalker graphWalker(ccLocation(), 0, *mTileMap, mConnectednessOverlay);
+	mConnectivity.update(*mTileMap, cc->state() == StructureState::UnderConstruction ? nullptr : &tile);
 }
 
 
-void MapViewState::checkCommRangeOverlay()
+/**
+ * Debug aid: writes how long each StructureClass took during the last
+ * turn's structure update, slowest first.
+ */
+void MapViewState::printUpdateTimes() const
 {
-	mCommRangeOverlay.clear();
+	const auto& updateTimes = Utility<StructureManager>::get().updateTimes();
+
+	std::vector<std::size_t> classes;
+	for (std::size_t i = 0; i < updateTimes.size(); ++i)
+	{
+		if (updateTimes[i].count() > 0) { classes.push_back(i); }
+	}
 
-	auto& structureManager = NAS2D::Utility<StructureManager>::get();
+	std::sort(classes.begin(), classes.end(), [&updateTimes](std::size_t a, std::size_t b) { return updateTimes[a] > updateTimes[b]; });
 
-	const auto& commTowers = structureManager.structureList(Structure::StructureClass::Communication);
-	const auto& command = structureManager.structureList(Structure::StructureClass::Command);
-	
-	for (auto cc : command)
+	std::cout << "Structure update times, last turn:" << std::endl;
+	for (auto index : classes)
 	{
-		if (!cc->operational()) { continue; }
-		auto& centerTile = structureManager.tileFromStructure(cc);
-		auto commAreaRect = buildAreaRectFromTile(centerTile, constants::ROBOT_COM_RANGE);
-		fillCommList(mCommRangeOverlay, *mTileMap, centerTile, commAreaRect, constants::ROBOT_COM_RANGE);
+		const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(updateTimes[index]).count();
+		std::cout << "  " << Structure::classDescription(static_cast<Structure::StructureClass>(index)) << ": " << microseconds << " us" << std::endl;
 	}
+}
+
 
-	for (auto tower : commTowers)
+/**
+ * Rebuilds the communications overlay if coverage changed.
+ */
+void MapViewState::checkCommRangeOverlay()
+{
+	auto& commRange = NAS2D::Utility<StructureManager>::get().commRangeGrid();
+	if (commRange.takeChanged())
 	{
-		if (!tower->operational()) { continue; }
-		auto& centerTile = structureManager.tileFromStructure(tower);
-		auto commAreaRect = buildAreaRectFromTile(centerTile, constants::COMM_TOWER_BASE_RANGE);
-		fillCommList(mCommRangeOverlay, *mTileMap, centerTile, commAreaRect, constants::COMM_TOWER_BASE_RANGE);
+		commRange.coveredTiles(*mTileMap, mCommRangeOverlay);
 	}
 }
 
@@ -1417,9 +1370,9 @@ void MapViewState::checkCommRangeOverlay()
  */
 void MapViewState::scrubRobotList()
 {
-	for (auto it : mRobotList)
+	for (const auto& task : mRobotList)
 	{
-		it.second->removeThing();
+		task.tile->removeThing();
 	}
 }
 
@@ -8,6 +8,10 @@
 
 #include "../Common.h"
 #include "../Constants.h"
+#include "../ConnectivityTracker.h"
+#include "../Map/GridPathfinder.h"
+#include "../Map/RouteIndex.h"
+#include "../Map/SectorGraph.h"
 #include "../StorableResources.h"
 #include "../RobotPool.h"
 #include "../PopulationPool.h"
@@ -23,6 +27,7 @@
 
 #include <string>
 #include <memory>
+#include <set>
 
 
 namespace NAS2D
@@ -33,11 +38,6 @@ namespace NAS2D
 	}
 }
 
-namespace micropather
-{
-	class MicroPather;
-}
-
 class Tile;
 class TileMap;
 class MainReportsUiState;
@@ -149,6 +149,7 @@ private:
 	void setMinimapView();
 
 	void checkCommRangeOverlay();
+	void printUpdateTimes() const;
 	void checkConnectedness();
 	void changeViewDepth(int);
 
@@ -172,6 +173,8 @@ private:
 	void updateRobots();
 
 	void findMineRoutes();
+	void updateTruckRouteOverlay();
+	void forgetMineRoute(MineFacility* facility);
 	void transportOreFromMines();
 	void transportResourcesToStorage();
 
@@ -250,7 +253,7 @@ private:
 	RobotPool mRobotPool; /**< Robots that are currently available for use. */
 	PopulationPool mPopulationPool;
 
-	RobotTileTable mRobotList; /**< List of active robots and their positions on the map. */
+	RobotTaskTable mRobotList; /**< Active robots, their positions on the map and their tasks. */
 
 	InsertMode mInsertMode = InsertMode::None; /**< What's being inserted into the TileMap if anything. */
 	StructureID mCurrentStructure = StructureID::SID_NONE; /**< Structure being placed. */
@@ -310,7 +313,11 @@ private:
 	MapChangedCallback mMapChangedCallback;
 
 	// ROUTING
-	micropather::MicroPather* mPathSolver = nullptr;
+	std::vector<GridPathfinder> mPathfinders; /**< One per WorkerPool worker. The first belongs to the calling thread. */
+	SectorGraph mSectorGraph;
+	RouteIndex mRouteIndex;
+	TileList mRouteSmelterTiles; /**< Smelters that were used by the last route search. */
+	std::set<MineFacility*> mUnroutedMines; /**< Mines that couldn't reach a smelter in the last route search. */
 
 	// MISCELLANEOUS
 	int mTurnCount = 0;
@@ -323,7 +330,7 @@ private:
 
 	int mResidentialCapacity = 0;
 
-	TileList mConnectednessOverlay;
+	ConnectivityTracker mConnectivity;
 	TileList mCommRangeOverlay;
 	TileList mTruckRouteOverlay;
 
@@ -84,7 +84,7 @@ void MapViewState::drawMiniMap()
 
 	for (auto minePosition : mTileMap->mineLocations())
 	{
-		Mine* mine = mTileMap->getTile(minePosition, 0).mine();
+		Mine* mine = mTileMap->mine(minePosition);
 		if (!mine) { break; } // avoids potential race condition where a mine is destroyed during an updated cycle.
 
 		auto mineBeaconStatusOffsetX = 0;
@@ -103,14 +103,14 @@ void MapViewState::drawMiniMap()
 	{
 		for (auto tile : route.second.path)
 		{
-			const auto tilePosition = static_cast<Tile*>(tile)->position();
+			const auto tilePosition = tile->position();
 			renderer.drawPoint(tilePosition + miniMapOffset, NAS2D::Color::Magenta);
 		}
 	}
 
-	for (auto robotEntry : mRobotList)
+	for (const auto& task : mRobotList)
 	{
-		const auto robotPosition = robotEntry.second->position();
+		const auto robotPosition = task.tile->position();
 		renderer.drawPoint(robotPosition + miniMapOffset, NAS2D::Color::Cyan);
 	}
 
@@ -113,7 +113,8 @@ void MapViewState::deployCargoLander()
 {
 	auto cc = static_cast<CommandCenter*>(mTileMap->getTile(ccLocation(), 0).structure());
 	cc->foodLevel(cc->foodLevel() + 125);
-	cc->storage() += StorableResources{ 25, 25, 15, 15 };
+	StorableResources cargo{ 25, 25, 15, 15 };
+	NAS2D::Utility<StructureManager>::get().resourceLedger().deposit(cargo);
 
 	updateStructuresAvailability();
 }
@@ -187,9 +188,8 @@ void MapViewState::dozerTaskFinished(Robot* /*robot*/)
  */
 void MapViewState::diggerTaskFinished(Robot* robot)
 {
-	if (mRobotList.find(robot) == mRobotList.end()) { throw std::runtime_error("MapViewState::diggerTaskFinished() called with a Robot not in the Robot List!"); }
-
-	Tile* t = mRobotList[robot];
+	Tile* t = mRobotList.tile(robot);
+	if (!t) { throw std::runtime_error("MapViewState::diggerTaskFinished() called with a Robot not in the Robot List!"); }
 
 	if (t->depth() > mTileMap->maxDepth())
 	{
@@ -216,8 +216,6 @@ void MapViewState::diggerTaskFinished(Robot* robot)
 		mTileMap->getTile(origin, t->depth()).index(TerrainType::Dozed);
 		mTileMap->getTile(origin, newDepth).index(TerrainType::Dozed);
 
-		/// \fixme Naive approach; will be slow with large colonies.
-		NAS2D::Utility<StructureManager>::get().disconnectAll();
 		checkConnectedness();
 	}
 	else if (dir == Direction::North)
@@ -256,12 +254,13 @@ void MapViewState::diggerTaskFinished(Robot* robot)
  */
 void MapViewState::minerTaskFinished(Robot* robot)
 {
-	if (mRobotList.find(robot) == mRobotList.end()) { throw std::runtime_error("MapViewState::minerTaskFinished() called with a Robot not in the Robot List!"); }
+	auto* robotTilePtr = mRobotList.tile(robot);
+	if (!robotTilePtr) { throw std::runtime_error("MapViewState::minerTaskFinished() called with a Robot not in the Robot List!"); }
 
-	auto& robotTile = *mRobotList[robot];
+	auto& robotTile = *robotTilePtr;
 
 	// Surface structure
-	MineFacility* mineFacility = new MineFacility(robotTile.mine());
+	MineFacility* mineFacility = new MineFacility(mTileMap->mine(robotTile));
 	mineFacility->maxDepth(mTileMap->maxDepth());
 	NAS2D::Utility<StructureManager>::get().addStructure(mineFacility, &robotTile);
 	mineFacility->extensionComplete().connect(this, &MapViewState::mineFacilityExtended);
@@ -19,6 +19,7 @@
 #include "../Things/Structures/Warehouse.h"
 
 #include <NAS2D/Utility.h>
+#include <NAS2D/Resources/Image.h>
 
 #include <cmath>
 
@@ -42,7 +43,7 @@ Point<int>& ccLocation()
  */
 bool checkTubeConnection(Tile& tile, Direction dir, ConnectorDir sourceConnectorDir)
 {
-	if (tile.mine() || !tile.bulldozed() || !tile.excavated() || !tile.thingIsStructure())
+	if (tile.hasMine() || !tile.bulldozed() || !tile.excavated() || !tile.thingIsStructure())
 	{
 		return false;
 	}
@@ -91,7 +92,7 @@ bool checkTubeConnection(Tile& tile, Direction dir, ConnectorDir sourceConnector
 bool checkStructurePlacement(Tile& tile, Direction dir)
 {
 	Structure* _structure = tile.structure();
-	if (tile.mine() || !tile.bulldozed() || !tile.excavated() || !tile.thingIsStructure() || !tile.connected() || !_structure->isConnector())
+	if (tile.hasMine() || !tile.bulldozed() || !tile.excavated() || !tile.thingIsStructure() || !tile.connected() || !_structure->isConnector())
 	{
 		return false;
 	}
@@ -190,7 +191,7 @@ bool landingSiteSuitable(TileMap* tilemap, NAS2D::Point<int> position)
 			doAlertMessage(constants::ALERT_LANDER_LOCATION, constants::ALERT_SEED_TERRAIN);
 			return false;
 		}
-		else if (tile.mine())
+		else if (tile.hasMine())
 		{
 			doAlertMessage(constants::ALERT_LANDER_LOCATION, constants::ALERT_SEED_MINE);
 			return false;
@@ -209,7 +210,7 @@ bool landingSiteSuitable(TileMap* tilemap, NAS2D::Point<int> position)
 /**
  * Document me!
  */
-void deleteRobotsInRCC(Robot* robotToDelete, RobotCommand* rcc, RobotPool& robotPool, RobotTileTable& rtt, Tile* /*tile*/)
+void deleteRobotsInRCC(Robot* robotToDelete, RobotCommand* rcc, RobotPool& robotPool, RobotTaskTable& robotTasks, Tile* /*tile*/)
 {
 	if (rcc->isControlling(robotToDelete))
 	{
@@ -217,11 +218,12 @@ void deleteRobotsInRCC(Robot* robotToDelete, RobotCommand* rcc, RobotPool& robot
 		return;
 	}
 
-	const RobotList& rl = rcc->robots();
+	// Deleting a robot removes it from the facility's list, so work from a copy
+	const RobotList rl = rcc->robots();
 
 	for (auto robot : rl)
 	{
-		if (rtt.find(robot) != rtt.end())
+		if (robotTasks.contains(robot))
 		{
 			robot->die();
 			continue;
@@ -280,39 +282,6 @@ bool selfSustained(StructureID id)
 }
 
 
-/** 
- * Indicates that a specified tile is out of communications range (out of range of a CC or Comm Tower).
- */
-bool inCommRange(NAS2D::Point<int> position)
-{
-	auto& structureManager = Utility<StructureManager>::get();
-
-	const auto& command = structureManager.structureList(Structure::StructureClass::Command);
-	for (auto cc : command)
-	{
-		if (!cc->operational()) { continue; }
-
-		if (isPointInRange(position, structureManager.tileFromStructure(cc).position(), constants::ROBOT_COM_RANGE))
-		{
-			return true;
-		}
-	}
-
-	const auto& commTowers = structureManager.structureList(Structure::StructureClass::Communication);
-	for (auto tower : commTowers)
-	{
-		if (!tower->operational()) { continue; }
-
-		if (isPointInRange(position, structureManager.tileFromStructure(tower).position(), constants::COMM_TOWER_BASE_RANGE))
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
-
 bool isPointInRange(NAS2D::Point<int> point1, NAS2D::Point<int> point2, int distance)
 {
 	return (point2 - point1).lengthSquared() <= distance * distance;
@@ -331,16 +300,8 @@ bool isPointInRange(NAS2D::Point<int> point1, NAS2D::Point<int> point2, int dist
  */
 Warehouse* getAvailableWarehouse(ProductType type, std::size_t count)
 {
-	for (auto structure : Utility<StructureManager>::get().structureList(Structure::StructureClass::Warehouse))
-	{
-		Warehouse* _wh = static_cast<Warehouse*>(structure);
-		if (_wh->products().canStore(type, static_cast<int>(count)))
-		{
-			return _wh;
-		}
-	}
-
-	return nullptr;
+	const auto storageRequired = storageRequiredPerUnit(type) * static_cast<int>(count);
+	return Utility<StructureManager>::get().warehouseIndex().find(storageRequired);
 }
 
 
@@ -368,6 +329,33 @@ RobotCommand* getAvailableRobotCommand()
 }
 
 
+/**
+ * Picks the operational warehouses that products from a warehouse would be
+ * moved into, most available storage first.
+ *
+ * \param	sourceWarehouse	Warehouse the products are moved out of.
+ * \param	sourcePool		Copy of the source warehouse's products. Products
+ *							that fit in the returned warehouses are removed.
+ */
+static std::vector<Warehouse*> productDestinations(Warehouse* sourceWarehouse, ProductPool& sourcePool)
+{
+	std::vector<Warehouse*> destinations;
+
+	const auto& warehouses = Utility<StructureManager>::get().warehouseIndex().byAvailableStorage();
+	for (auto it = warehouses.rbegin(); it != warehouses.rend() && !sourcePool.empty(); ++it)
+	{
+		const auto [availableStorage, warehouse] = *it;
+		if (availableStorage <= 0) { break; }
+		if (warehouse == sourceWarehouse || !warehouse->operational()) { continue; }
+
+		sourcePool.transferAllTo(availableStorage);
+		destinations.push_back(warehouse);
+	}
+
+	return destinations;
+}
+
+
 /**
  * Simulates moving the products out of a specified warehouse and raises
  * an alert to the user if not all products can be moved out of the
@@ -379,23 +367,7 @@ RobotCommand* getAvailableRobotCommand()
 bool simulateMoveProducts(Warehouse* sourceWarehouse)
 {
 	ProductPool sourcePool = sourceWarehouse->products();
-	const auto& structures = Utility<StructureManager>::get().structureList(Structure::StructureClass::Warehouse);
-	for (auto structure : structures)
-	{
-		if (structure->operational())
-		{
-			Warehouse* warehouse = static_cast<Warehouse*>(structure);
-			if (warehouse != sourceWarehouse)
-			{
-				ProductPool destinationPool = warehouse->products();
-				sourcePool.transferAllTo(destinationPool);
-				if (sourcePool.empty())
-				{
-					return true;
-				}
-			}
-		}
-	}
+	productDestinations(sourceWarehouse, sourcePool);
 
 	if (sourcePool.empty())
 	{
@@ -411,17 +383,10 @@ bool simulateMoveProducts(Warehouse* sourceWarehouse)
  */
 void moveProducts(Warehouse* sourceWarehouse)
 {
-	const auto& structures = Utility<StructureManager>::get().structureList(Structure::StructureClass::Warehouse);
-	for (auto structure : structures)
+	ProductPool sourcePool = sourceWarehouse->products();
+	for (auto warehouse : productDestinations(sourceWarehouse, sourcePool))
 	{
-		if (structure->operational())
-		{
-			Warehouse* warehouse = static_cast<Warehouse*>(structure);
-			if (warehouse != sourceWarehouse)
-			{
-				sourceWarehouse->products().transferAllTo(warehouse->products());
-			}
-		}
+		sourceWarehouse->products().transferAllTo(warehouse->products());
 	}
 }
 
@@ -449,31 +414,12 @@ void resourceShortageMessage(const StorableResources& resources, StructureID sid
 
 /**
  * Add refined resources to the players storage structures.
+ *
+ * \note	Anything that doesn't fit is left in \c resourcesToAdd.
  */
 void addRefinedResources(StorableResources& resourcesToAdd)
 {
-	StructureList storage = NAS2D::Utility<StructureManager>::get().structureList(Structure::StructureClass::Storage);
-
-	/**
-	 * The Command Center acts as backup storage especially during the beginning of the
-	 * game before storage tanks are built. This ensure that the CC is in the storage
-	 * structure list and that it's always the first structure in the list.
-	 */
-	auto& command = NAS2D::Utility<StructureManager>::get().structureList(Structure::StructureClass::Command);
-	storage.insert(storage.begin(), command.begin(), command.end());
-
-	for (auto structure : storage)
-	{
-		if (resourcesToAdd.isEmpty()) { break; }
-
-		auto& storageTanksResources = structure->storage();
-
-		auto newResources = storageTanksResources + resourcesToAdd;
-		auto capped = newResources.cap(structure->storageCapacity() / 4);
-
-		storageTanksResources = capped;
-		resourcesToAdd = newResources - capped;
-	}
+	NAS2D::Utility<StructureManager>::get().resourceLedger().deposit(resourcesToAdd);
 }
 
 
@@ -485,23 +431,7 @@ void addRefinedResources(StorableResources& resourcesToAdd)
  */
 void removeRefinedResources(StorableResources& resourcesToRemove)
 {
-	StructureList storage = NAS2D::Utility<StructureManager>::get().structureList(Structure::StructureClass::Storage);
-
-	// Command Center is backup storage, we want to pull from it last
-	auto& command = NAS2D::Utility<StructureManager>::get().structureList(Structure::StructureClass::Command);
-	storage.insert(storage.end(), command.begin(), command.end());
-
-	for (auto structure : storage)
-	{
-		if (resourcesToRemove.isEmpty()) { break; }
-
-		auto& resourcesInStorage = structure->storage().resources;
-		for (size_t i = 0; i < resourcesInStorage.size(); ++i)
-		{
-			const int pulled = pullResource(resourcesInStorage[i], resourcesToRemove.resources[i]);
-			resourcesToRemove.resources[i] -= pulled;
-		}
-	}
+	NAS2D::Utility<StructureManager>::get().resourceLedger().withdraw(resourcesToRemove);
 }
 
 
@@ -538,6 +468,28 @@ void resetTileIndexFromDozer(Robot* robot, Tile* tile)
 }
 
 
+/**
+ * Builds the minimap height view from the TileMap's decoded terrain
+ * grid so the height map image doesn't need to be loaded a second time.
+ */
+std::unique_ptr<NAS2D::Image> buildHeightMapImage(const TileMap& tileMap)
+{
+	const auto& terrain = tileMap.terrainGrid();
+
+	std::vector<std::uint8_t> pixels(terrain.size() * 4);
+	for (std::size_t i = 0; i < terrain.size(); ++i)
+	{
+		const auto value = static_cast<std::uint8_t>(static_cast<int>(terrain[i]) * 50);
+		pixels[i * 4 + 0] = value;
+		pixels[i * 4 + 1] = value;
+		pixels[i * 4 + 2] = value;
+		pixels[i * 4 + 3] = 255;
+	}
+
+	return std::make_unique<NAS2D::Image>(pixels.data(), 4, tileMap.size());
+}
+
+
 
 // ==============================================================
 // = CONVENIENCE FUNCTIONS FOR WRITING OUT GAME STATE INFORMATION
@@ -546,17 +498,17 @@ void resetTileIndexFromDozer(Robot* robot, Tile* tile)
 /** 
  * Document me!
  */
-void checkRobotDeployment(XmlElement* _ti, RobotTileTable& _rm, Robot* _r, Robot::Type _type)
+void checkRobotDeployment(XmlElement* _ti, RobotTaskTable& _rm, Robot* _r, Robot::Type _type)
 {
 	_ti->attribute("id", _r->id());
 	_ti->attribute("type", static_cast<int>(_type));
 	_ti->attribute("age", _r->fuelCellAge());
 	_ti->attribute("production", _r->turnsToCompleteTask());
 
-	const auto it = _rm.find(_r);
-	if (it != _rm.end())
+	const auto* deployedTile = _rm.tile(_r);
+	if (deployedTile)
 	{
-		const auto& tile = *it->second;
+		const auto& tile = *deployedTile;
 		const auto position = tile.position();
 		_ti->attribute("x", position.x);
 		_ti->attribute("y", position.y);
@@ -570,7 +522,7 @@ void checkRobotDeployment(XmlElement* _ti, RobotTileTable& _rm, Robot* _r, Robot
  * 
  * Convenience function
  */
-void writeRobots(NAS2D::Xml::XmlElement* element, RobotPool& robotPool, RobotTileTable& robotMap)
+void writeRobots(NAS2D::Xml::XmlElement* element, RobotPool& robotPool, RobotTaskTable& robotMap)
 {
 	XmlElement* robots = new XmlElement("robots");
 
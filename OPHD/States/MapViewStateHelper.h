@@ -11,8 +11,12 @@
 
 #include "../Common.h"
 
+#include <memory>
+
 
 namespace NAS2D {
+	class Image;
+
 	namespace Xml {
 		class XmlElement;
 	}
@@ -23,11 +27,10 @@ class TileMap;
 class Warehouse; /**< Forward declaration for getAvailableWarehouse() function. */
 class RobotCommand; /**< Forward declaration for getAvailableRobotCommand() function. */
 class RobotPool;
+class RobotTaskTable;
 class Robot;
 struct StorableResources;
 
-using RobotTileTable = std::map<Robot*, Tile*>;
-
 extern const NAS2D::Point<int> CcNotPlaced;
 NAS2D::Point<int>& ccLocation();
 
@@ -38,7 +41,6 @@ bool validStructurePlacement(TileMap* tilemap, NAS2D::Point<int> point);
 bool validLanderSite(Tile& t);
 bool landingSiteSuitable(TileMap* tilemap, NAS2D::Point<int> position);
 bool structureIsLander(StructureID id);
-bool inCommRange(NAS2D::Point<int> position);
 bool isPointInRange(NAS2D::Point<int> point1, NAS2D::Point<int> point2, int distance);
 bool selfSustained(StructureID id);
 
@@ -56,8 +58,10 @@ int pullResource(int& resource, int amount);
 
 void resetTileIndexFromDozer(Robot* robot, Tile* tile);
 
+std::unique_ptr<NAS2D::Image> buildHeightMapImage(const TileMap& tileMap);
+
 // Serialize / Deserialize
-void writeRobots(NAS2D::Xml::XmlElement* element, RobotPool& robotPool, RobotTileTable& robotMap);
+void writeRobots(NAS2D::Xml::XmlElement* element, RobotPool& robotPool, RobotTaskTable& robotTasks);
 
 void updateRobotControl(RobotPool& robotPool);
-void deleteRobotsInRCC(Robot* robot, RobotCommand* rcc, RobotPool& robotPool, RobotTileTable& rtt, Tile* tile);
+void deleteRobotsInRCC(Robot* robot, RobotCommand* rcc, RobotPool& robotPool, RobotTaskTable& robotTasks, Tile* tile);
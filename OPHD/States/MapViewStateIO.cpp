@@ -9,6 +9,7 @@
 #include "../Cache.h"
 #include "../Constants.h"
 #include "../IOHelper.h"
+#include "../SessionArena.h"
 #include "../StructureCatalogue.h"
 #include "../StructureManager.h"
 #include "../Map/TileMap.h"
@@ -31,7 +32,6 @@ using namespace NAS2D::Xml;
 
 
 /// \fixme	Fugly, find a sane way to do this.
-extern const std::string MAP_TERRAIN_EXTENSION = "_a.png";
 extern const std::string MAP_DISPLAY_EXTENSION = "_b.png";
 
 extern std::string CURRENT_LEVEL_STRING;
@@ -62,14 +62,10 @@ static void readRccRobots(NAS2D::Xml::XmlAttribute* attr, Structure& structure,
 
 	for (const auto& string : NAS2D::split(attr->value(), ','))
 	{
-		const auto robotId = NAS2D::stringTo<int>(string);
-		for (auto* robot : pool.robots())
+		auto* robot = pool.findRobot(NAS2D::stringTo<int>(string));
+		if (robot != nullptr)
 		{
-			if (robot->id() == robotId)
-			{
-				static_cast<RobotCommand*>(&structure)->addRobot(robot);
-				break;
-			}
+			static_cast<RobotCommand*>(&structure)->addRobot(robot);
 		}
 	}
 }
@@ -156,21 +152,35 @@ void MapViewState::load(const std::string& filePath)
 		throw std::runtime_error("File '" + filePath + "' was not found.");
 	}
 
+	// Everything from the old session has to be gone before the arena
+	// releases its blocks.
 	scrubRobotList();
+	mRobotList.clear();
+	mRobotPool.clear();
 	Utility<StructureManager>::get().dropAllStructures();
 	ccLocation() = CcNotPlaced;
 
 	delete mTileMap;
 	mTileMap = nullptr;
+	Utility<SessionArena>::get().release();
+	mConnectivity.reset();
+	mCommRangeOverlay.clear();
 
 	auto xmlDocument = openSavegame(filePath);
 	auto* root = xmlDocument.firstChildElement(constants::SAVE_GAME_ROOT_NODE);
 
+	// Saves from before map dimensions were recorded are always 300x150.
+	const Planet::Attributes defaultAttributes;
+	mPlanetAttributes.mapWidth = defaultAttributes.mapWidth;
+	mPlanetAttributes.mapHeight = defaultAttributes.mapHeight;
+
 	XmlElement* map = root->firstChildElement("properties");
 	XmlAttribute* attribute = map->firstAttribute();
 	while (attribute)
 	{
 		if (attribute->name() == "diggingdepth") { attribute->queryIntValue(mPlanetAttributes.maxDepth); }
+		else if (attribute->name() == "width") { attribute->queryIntValue(mPlanetAttributes.mapWidth); }
+		else if (attribute->name() == "height") { attribute->queryIntValue(mPlanetAttributes.mapHeight); }
 		else if (attribute->name() == "sitemap") { mPlanetAttributes.mapImagePath = attribute->value(); }
 		else if (attribute->name() == "tset") { mPlanetAttributes.tilesetPath = attribute->value(); }
 		else if (attribute->name() == "meansolardistance") { mPlanetAttributes.meanSolarDistance = std::stof(attribute->value()); }
@@ -179,14 +189,18 @@ void MapViewState::load(const std::string& filePath)
 
 	StructureCatalogue::init(mPlanetAttributes.meanSolarDistance);
 	mMapDisplay = std::make_unique<Image>(mPlanetAttributes.mapImagePath + MAP_DISPLAY_EXTENSION);
-	mHeightMap = std::make_unique<Image>(mPlanetAttributes.mapImagePath + MAP_TERRAIN_EXTENSION);
-	mTileMap = new TileMap(mPlanetAttributes.mapImagePath, mPlanetAttributes.tilesetPath, mPlanetAttributes.maxDepth, 0, Planet::Hostility::None, false);
+	mTileMap = new TileMap(mPlanetAttributes.mapImagePath, mPlanetAttributes.tilesetPath, {mPlanetAttributes.mapWidth, mPlanetAttributes.mapHeight}, mPlanetAttributes.maxDepth, 0, Planet::Hostility::None, false);
+	mHeightMap = buildHeightMapImage(*mTileMap);
+	Utility<StructureManager>::get().commRangeGrid().reset(mTileMap->size());
 	mTileMap->deserialize(root);
 
-	delete mPathSolver;
-	mPathSolver = new micropather::MicroPather(mTileMap);
 	auto& routeTable = NAS2D::Utility<std::map<class MineFacility*, Route>>::get();
 	routeTable.clear();
+	mRouteIndex.clear();
+	mRouteSmelterTiles.clear();
+	mUnroutedMines.clear();
+	mTruckRouteOverlay.clear();
+	mSectorGraph.reset(*mTileMap);
 
 	/**
 	 * In the case of loading a game, the Robot Command Center depends on the robot list
@@ -195,6 +209,7 @@ void MapViewState::load(const std::string& filePath)
 	 */
 	readRobots(root->firstChildElement("robots"));
 	readStructures(root->firstChildElement("structures"));
+	Utility<StructureManager>::get().resourceLedger().recount();
 
 	readResources(root->firstChildElement("prev_resources"), mResourceBreakdownPanel.previousResources());
 	readPopulation(root->firstChildElement("population"));
@@ -316,12 +331,12 @@ void MapViewState::readRobots(Xml::XmlElement* element)
 		{
 			robot->startTask(production_time);
 			mRobotPool.insertRobotIntoTable(mRobotList, robot, &mTileMap->getTile({x, y}, depth));
-			mRobotList[robot]->index(TerrainType::Dozed);
+			mRobotList.tile(robot)->index(TerrainType::Dozed);
 		}
 
-		if (depth > 0)
+		if (depth > 0 && mRobotList.contains(robot))
 		{
-			mRobotList[robot]->excavated(true);
+			mRobotList.tile(robot)->excavated(true);
 		}
 	}
 
@@ -383,7 +398,7 @@ void MapViewState::readStructures(Xml::XmlElement* element)
 
 		if (structureId == StructureID::SID_MINE_FACILITY)
 		{
-			auto* mine = mTileMap->getTile({x, y}, 0).mine();
+			auto* mine = mTileMap->mine({x, y});
 			if (mine == nullptr)
 			{
 				throw std::runtime_error("Mine Facility is located on a Tile with no Mine.");
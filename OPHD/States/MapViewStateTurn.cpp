@@ -13,6 +13,7 @@
 #include "../DirectionOffset.h"
 #include "../StorableResources.h"
 #include "../StructureManager.h"
+#include "../WorkerPool.h"
 
 #include <NAS2D/Utility.h>
 #include <NAS2D/Renderer/Renderer.h>
@@ -33,42 +34,24 @@ static inline void pullFoodFromStructure(FoodProduction* producer, int& remainde
 }
 
 
-static RouteList findRoutes(micropather::MicroPather* solver, TileMap* tilemap, Structure* mine, const StructureList& smelters)
-{
-	auto& structureManager = NAS2D::Utility<StructureManager>::get();
-
-	auto& start = structureManager.tileFromStructure(mine);
-
-	RouteList routeList;
-
-	for (auto smelter : smelters)
-	{
-		auto& end = structureManager.tileFromStructure(smelter);
-		tilemap->pathStartAndEnd(&start, &end);
-		Route route;
-		solver->Solve(&start, &end, &route.path, &route.cost);
-
-		if (!route.empty()) { routeList.push_back(route); }
-	}
-
-	return routeList;
-}
-
-
-static Route findLowestCostRoute(RouteList& routeList)
+/**
+ * Checks whether a route can still be used.
+ *
+ * A route is obstructed when anything other than a road has been built
+ * along it, the terrain has become impassable, or either of its endpoints
+ * no longer holds the mine or a smelter.
+ */
+static bool routeObstructed(const Route& route, MineFacility* facility)
 {
-	if (routeList.empty()) { return Route(); }
-
-	std::sort(routeList.begin(), routeList.end(), [](const Route& a, const Route& b) { return a.cost < b.cost; });
-	return routeList.front();
-}
+	const auto* mineTile = route.path.front();
+	const auto* smelterTile = route.path.back();
 
+	if (mineTile->structure() != facility) { return true; }
+	if (!smelterTile->thingIsStructure() || smelterTile->structure()->structureClass() != Structure::StructureClass::Smelter) { return true; }
 
-static bool routeObstructed(Route& route)
-{
-	for (auto tile : route.path)
+	for (std::size_t i = 1; i + 1 < route.path.size(); ++i)
 	{
-		Tile* t = static_cast<Tile*>(tile);
+		const Tile* t = route.path[i];
 
 		// \note	Tile being occupied by a robot is not an obstruction for the
 		//			purposes of routing/pathing.
@@ -218,14 +201,49 @@ void MapViewState::updateMorale()
 }
 
 
+/**
+ * Finds routes for mines that don't have one.
+ *
+ * Routes are kept between turns. Only routes that pass through a tile that
+ * changed since the last turn are rechecked, and a new search only runs
+ * when a mine actually needs a route.
+ */
 void MapViewState::findMineRoutes()
 {
-	auto& smelterList = NAS2D::Utility<StructureManager>::get().structureList(Structure::StructureClass::Smelter);
+	auto& structureManager = NAS2D::Utility<StructureManager>::get();
 	auto& routeTable = NAS2D::Utility<std::map<class MineFacility*, Route>>::get();
-	mPathSolver->Reset();
-	mTruckRouteOverlay.clear();
 
-	for (auto mine : NAS2D::Utility<StructureManager>::get().structureList(Structure::StructureClass::Mine))
+	const auto changedTiles = mTileMap->takeChangedSurfaceTiles();
+	mSectorGraph.update(*mTileMap, changedTiles);
+
+	for (auto tileIndex : changedTiles)
+	{
+		const auto facilities = mRouteIndex.routesThrough(tileIndex);
+		for (auto facility : facilities)
+		{
+			auto routeIt = routeTable.find(facility);
+			if (routeIt == routeTable.end() || routeObstructed(routeIt->second, facility))
+			{
+				routeTable.erase(facility);
+				mRouteIndex.remove(facility);
+			}
+		}
+	}
+
+	TileList smelterTiles;
+	for (auto smelter : structureManager.structureList(Structure::StructureClass::Smelter))
+	{
+		if (smelter->operational()) { smelterTiles.push_back(&structureManager.tileFromStructure(smelter)); }
+	}
+
+	// Mines that failed to find a route are only retried once something
+	// that could open one up has changed.
+	const bool routingChanged = !changedTiles.empty() || smelterTiles != mRouteSmelterTiles;
+
+	std::vector<MineFacility*> facilitiesNeedingRoutes;
+	GridPathfinder::Path mineIndexes;
+
+	for (auto mine : structureManager.structureList(Structure::StructureClass::Mine))
 	{
 		MineFacility* facility = static_cast<MineFacility*>(mine);
 		facility->mine()->checkExhausted();
@@ -233,32 +251,132 @@ void MapViewState::findMineRoutes()
 		if (!mine->operational() && !mine->isIdle()) { continue; } // consider a different control path.
 
 		auto routeIt = routeTable.find(facility);
-		bool findNewRoute = routeIt == routeTable.end();
+		if (routeIt != routeTable.end())
+		{
+			const auto* smelterTile = routeIt->second.path.back();
+			if (smelterTile->structure()->operational()) { continue; }
 
-		if (!findNewRoute && routeObstructed(routeIt->second))
+			routeTable.erase(routeIt);
+			mRouteIndex.remove(facility);
+		}
+		else if (!routingChanged && mUnroutedMines.count(facility) > 0)
 		{
-			routeTable.erase(facility);
-			findNewRoute = true;
+			continue;
 		}
 
-		if (findNewRoute)
+		facilitiesNeedingRoutes.push_back(facility);
+		mineIndexes.push_back(mTileMap->tileIndex(structureManager.tileFromStructure(mine).position(), 0));
+	}
+
+	if (facilitiesNeedingRoutes.empty())
+	{
+		updateTruckRouteOverlay();
+		return;
+	}
+
+	mRouteSmelterTiles = smelterTiles;
+
+	GridPathfinder::Path smelterIndexes;
+	for (auto tile : smelterTiles)
+	{
+		smelterIndexes.push_back(mTileMap->tileIndex(tile->position(), 0));
+	}
+
+	auto& workerPool = NAS2D::Utility<WorkerPool>::get();
+	mPathfinders.resize(workerPool.workerCount());
+	auto& pathfinder = mPathfinders.front();
+
+	const auto& costGrid = mSectorGraph.costGrid();
+	std::vector<GridPathfinder::Path> paths(mineIndexes.size());
+	std::vector<float> costs(mineIndexes.size(), FLT_MAX);
+
+	// Large maps route through the sector graph so long routes only search
+	// the sectors they cross. Mines it can't route fall back to the exact
+	// search below.
+	if (costGrid.size.x * costGrid.size.y > constants::ROUTE_HIERARCHY_MIN_TILES)
+	{
+		mSectorGraph.refresh(pathfinder);
+		mSectorGraph.destinations(pathfinder, smelterIndexes);
+
+		// Each mine's route is independent and the sector graph is only read
+		// from here, so they're solved in parallel. Results go to per-mine
+		// slots and are merged in mine order below so the outcome matches a
+		// serial run.
+		const auto& sectorGraph = mSectorGraph;
+		workerPool.run(mineIndexes.size(), [&](std::size_t i, std::size_t worker)
 		{
-			auto routeList = findRoutes(mPathSolver, mTileMap, mine, smelterList);
-			auto newRoute = findLowestCostRoute(routeList);
+			costs[i] = sectorGraph.findRoute(mPathfinders[worker], mineIndexes[i], paths[i]);
+		});
+	}
 
-			if (newRoute.empty()) { continue; } // give up and move on to the next mine
+	GridPathfinder::Path exactMineIndexes;
+	for (std::size_t i = 0; i < mineIndexes.size(); ++i)
+	{
+		if (costs[i] == FLT_MAX) { exactMineIndexes.push_back(mineIndexes[i]); }
+	}
 
-			routeTable[facility] = newRoute;
+	if (!exactMineIndexes.empty())
+	{
+		// One search from every smelter at once covers all of the mines.
+		pathfinder.searchFrom(costGrid, smelterIndexes, exactMineIndexes);
+		for (std::size_t i = 0; i < mineIndexes.size(); ++i)
+		{
+			if (costs[i] == FLT_MAX) { costs[i] = pathfinder.pathFrom(mineIndexes[i], paths[i]); }
+		}
+	}
 
-			for (auto tile : newRoute.path)
-			{
-				mTruckRouteOverlay.push_back(static_cast<Tile*>(tile));
-			}
+	for (std::size_t i = 0; i < facilitiesNeedingRoutes.size(); ++i)
+	{
+		Route newRoute;
+		newRoute.cost = costs[i];
+		for (auto index : paths[i])
+		{
+			newRoute.path.push_back(&mTileMap->surfaceTile(index));
 		}
+
+		if (newRoute.empty())
+		{
+			mUnroutedMines.insert(facilitiesNeedingRoutes[i]);
+			continue; // give up and move on to the next mine
+		}
+
+		mUnroutedMines.erase(facilitiesNeedingRoutes[i]);
+		routeTable[facilitiesNeedingRoutes[i]] = newRoute;
+		mRouteIndex.add(facilitiesNeedingRoutes[i], newRoute, *mTileMap);
+	}
+
+	updateTruckRouteOverlay();
+}
+
+
+/**
+ * Rebuilds the trucking route overlay from every route in the route table,
+ * including routes kept from earlier turns.
+ */
+void MapViewState::updateTruckRouteOverlay()
+{
+	mTruckRouteOverlay.clear();
+
+	for (const auto& [facility, route] : NAS2D::Utility<std::map<class MineFacility*, Route>>::get())
+	{
+		mTruckRouteOverlay.insert(mTruckRouteOverlay.end(), route.path.begin(), route.path.end());
 	}
 }
 
 
+/**
+ * Drops everything kept about a mine facility's route. Called before the
+ * facility is removed so a later structure allocated at the same address
+ * doesn't inherit its route or its unrouted status.
+ */
+void MapViewState::forgetMineRoute(MineFacility* facility)
+{
+	NAS2D::Utility<std::map<class MineFacility*, Route>>::get().erase(facility);
+	mRouteIndex.remove(facility);
+	mUnroutedMines.erase(facility);
+}
+
+
 void MapViewState::transportOreFromMines()
 {
 	auto& routeTable = NAS2D::Utility<std::map<class MineFacility*, Route>>::get();
@@ -268,8 +386,8 @@ void MapViewState::transportOreFromMines()
 		if (routeIt != routeTable.end())
 		{
 			const auto& route = routeIt->second;
-			const auto smelter = static_cast<Smelter*>(static_cast<Tile*>(route.path.back())->structure());
-			const auto mineFacility = static_cast<MineFacility*>(static_cast<Tile*>(route.path.front())->structure());
+			const auto smelter = static_cast<Smelter*>(route.path.back()->structure());
+			const auto mineFacility = static_cast<MineFacility*>(route.path.front()->structure());
 
 			if (!smelter->operational()) { break; }
 
@@ -503,7 +621,6 @@ void MapViewState::nextTurn()
 
 	mResourceBreakdownPanel.previousResources(mResourcesCount);
 
-	NAS2D::Utility<StructureManager>::get().disconnectAll();
 	checkConnectedness();
 	NAS2D::Utility<StructureManager>::get().update(mResourcesCount, mPopulationPool);
 
@@ -24,7 +24,7 @@
 using namespace constants;
 
 
-static void setOverlay(Button& button, TileList& tileList, Tile::Overlay overlay)
+static void setOverlay(Button& button, const TileList& tileList, Tile::Overlay overlay)
 {
 	auto overlayToUse = button.toggled() ? overlay : Tile::Overlay::None;
 	for (auto tile : tileList)
@@ -429,7 +429,7 @@ void MapViewState::btnToggleConnectednessClicked()
 		btnToggleRouteOverlayClicked();
 	}
 
-	setOverlay(mBtnToggleConnectedness, mConnectednessOverlay, Tile::Overlay::Connectedness);
+	setOverlay(mBtnToggleConnectedness, mConnectivity.tiles(), Tile::Overlay::Connectedness);
 }
 
 
@@ -527,9 +527,7 @@ void MapViewState::diggerSelectionDialog(Direction direction, Tile* tile)
 	if (tile->depth() > 0 && direction == Direction::Down)
 	{
 		NAS2D::Utility<StructureManager>::get().removeStructure(tile->structure());
-		NAS2D::Utility<StructureManager>::get().disconnectAll();
 		tile->deleteThing();
-		tile->connected(false);
 		checkConnectedness();
 	}
 
@@ -162,6 +162,14 @@ namespace
 			{
 				::parseElementValue(attributes.maxMines, element);
 			}
+			else if (element->value() == "MapWidth")
+			{
+				::parseElementValue(attributes.mapWidth, element);
+			}
+			else if (element->value() == "MapHeight")
+			{
+				::parseElementValue(attributes.mapHeight, element);
+			}
 			else if (element->value() == "MapImagePath")
 			{
 				::parseElementValue(attributes.mapImagePath, element);
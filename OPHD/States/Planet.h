@@ -40,6 +40,8 @@ public:
 		Hostility hostility = Hostility::None;
 		int maxDepth = 0;
 		int maxMines = 0;
+		int mapWidth = 300;
+		int mapHeight = 150;
 		std::string mapImagePath;
 		std::string tilesetPath;
 		std::string name;
@@ -3,11 +3,13 @@
 #include <map>
 #include <vector>
 
+class Tile;
+
 struct Route
 {
 	bool empty() const { return path.empty(); }
 
-	std::vector<void*> path;
+	std::vector<Tile*> path;
 	float cost = 0.0f;
 };
 
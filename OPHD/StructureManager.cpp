@@ -4,14 +4,18 @@
 #include "ProductPool.h"
 #include "IOHelper.h"
 #include "PopulationPool.h"
+#include "WorkerPool.h"
 #include "Map/Tile.h"
 #include "Things/Robots/Robot.h"
 #include "Things/Structures/Structures.h"
 
-#include "States/MapViewStateHelper.h" // <-- For removeRefinedResources()
+#include <NAS2D/Utility.h>
 
 #include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
 
 
 namespace {
@@ -23,12 +27,111 @@ namespace {
 		available[0] = std::min(required[0], populationPool.populationAvailable(Population::PersonRole::ROLE_WORKER));
 		available[1] = std::min(required[1], populationPool.populationAvailable(Population::PersonRole::ROLE_SCIENTIST));
 	}
+
+
+	/**
+	 * Colony wide work done after a phase finishes, before any lower
+	 * priority class is updated.
+	 */
+	enum class UpdateBarrier
+	{
+		None,
+		EnergyProduction, /**< Recompute energy output so later classes see this turn's supply. */
+		ChapAvailability /**< Recheck CHAP now that life support facilities have been updated. */
+	};
+
+
+	/**
+	 * How a class's think() calls may be run.
+	 */
+	enum class ThinkMode
+	{
+		Serial, /**< think() touches shared state or raises signals directly. */
+		Parallel /**< think() only touches the structure's own state. */
+	};
+
+
+	struct UpdatePhase
+	{
+		Structure::StructureClass structureClass;
+		UpdateBarrier barrier;
+		ThinkMode thinkMode;
+	};
+
+
+	/**
+	 * Structures per parallel think() task. Chunks are fixed size so
+	 * the work split doesn't depend on the number of cores.
+	 */
+	constexpr std::size_t ThinkChunkSize = 64;
+
+
+	/**
+	 * Order in which structure classes are updated, highest priority first.
+	 *
+	 * Higher priority classes get first claim on population, energy and
+	 * resources. Classes not listed (e.g., tubes) aren't updated.
+	 *
+	 * Classes marked Parallel have think() calls run across the WorkerPool
+	 * once every structure in the class has been checked and charged.
+	 */
+	constexpr UpdatePhase UpdatePhases[] =
+	{
+		{ Structure::StructureClass::Lander, UpdateBarrier::None, ThinkMode::Serial }, // No resource needs
+		{ Structure::StructureClass::Command, UpdateBarrier::None, ThinkMode::Serial }, // Self sufficient
+		{ Structure::StructureClass::EnergyProduction, UpdateBarrier::EnergyProduction, ThinkMode::Serial }, // Nothing can work without energy
+
+		// Basic resource production
+		{ Structure::StructureClass::Mine, UpdateBarrier::None, ThinkMode::Parallel }, // Can't operate without resources.
+		{ Structure::StructureClass::Smelter, UpdateBarrier::None, ThinkMode::Parallel },
+
+		{ Structure::StructureClass::LifeSupport, UpdateBarrier::ChapAvailability, ThinkMode::Serial }, // Air, water food must come before others
+		{ Structure::StructureClass::FoodProduction, UpdateBarrier::None, ThinkMode::Parallel },
+
+		{ Structure::StructureClass::MedicalCenter, UpdateBarrier::None, ThinkMode::Serial }, // No medical facilities, people die
+		{ Structure::StructureClass::Nursery, UpdateBarrier::None, ThinkMode::Serial },
+
+		// Factories have nothing to think() about. Production runs afterwards
+		// from MapViewState::nextTurn(), in list order, and draws
+		// from the shared ResourceLedger so it can't be split across workers.
+		{ Structure::StructureClass::Factory, UpdateBarrier::None, ThinkMode::Serial },
+
+		{ Structure::StructureClass::Storage, UpdateBarrier::None, ThinkMode::Serial }, // Everything else.
+		{ Structure::StructureClass::Park, UpdateBarrier::None, ThinkMode::Serial },
+		{ Structure::StructureClass::SurfacePolice, UpdateBarrier::None, ThinkMode::Serial },
+		{ Structure::StructureClass::UndergroundPolice, UpdateBarrier::None, ThinkMode::Serial },
+		{ Structure::StructureClass::RecreationCenter, UpdateBarrier::None, ThinkMode::Serial },
+		{ Structure::StructureClass::Recycling, UpdateBarrier::None, ThinkMode::Serial },
+		{ Structure::StructureClass::Residence, UpdateBarrier::None, ThinkMode::Parallel },
+		{ Structure::StructureClass::RobotCommand, UpdateBarrier::None, ThinkMode::Serial },
+		{ Structure::StructureClass::Warehouse, UpdateBarrier::None, ThinkMode::Serial },
+		{ Structure::StructureClass::Laboratory, UpdateBarrier::None, ThinkMode::Serial },
+		{ Structure::StructureClass::Commercial, UpdateBarrier::None, ThinkMode::Serial },
+		{ Structure::StructureClass::University, UpdateBarrier::None, ThinkMode::Serial },
+		{ Structure::StructureClass::Communication, UpdateBarrier::None, ThinkMode::Serial },
+		{ Structure::StructureClass::Road, UpdateBarrier::None, ThinkMode::Serial },
+
+		{ Structure::StructureClass::Undefined, UpdateBarrier::None, ThinkMode::Serial }
+	};
+}
+
+
+StructureManager::StructureManager() :
+	mMainThread{std::this_thread::get_id()}
+{
+	Structure::stateChanged().connect(this, &StructureManager::onStructureStateChanged);
+}
+
+
+StructureManager::~StructureManager()
+{
+	Structure::stateChanged().disconnect(this, &StructureManager::onStructureStateChanged);
 }
 
 
 bool StructureManager::CHAPAvailable()
 {
-	for (auto chap : mStructureLists[Structure::StructureClass::LifeSupport])
+	for (auto chap : classList(Structure::StructureClass::LifeSupport))
 	{
 		if (chap->operational()) { return true; }
 	}
@@ -37,45 +140,90 @@ bool StructureManager::CHAPAvailable()
 }
 
 
+/**
+ * Communications range of structures that transmit, 0 for any other structure.
+ */
+int StructureManager::transmitterRange(const Structure& structure)
+{
+	switch (structure.structureClass())
+	{
+	case Structure::StructureClass::Command:
+		return constants::ROBOT_COM_RANGE;
+
+	case Structure::StructureClass::Communication:
+		return constants::COMM_TOWER_BASE_RANGE;
+
+	default:
+		return 0;
+	}
+}
+
+
+/**
+ * Adds a managed transmitter's coverage while it's operational and
+ * removes it otherwise.
+ */
+void StructureManager::updateTransmitter(const Structure& structure)
+{
+	const auto range = transmitterRange(structure);
+	if (range == 0) { return; }
+
+	if (structure.operational() && structure.mTile != nullptr)
+	{
+		mCommRange.addTransmitter(&structure, structure.mTile->position(), range);
+	}
+	else
+	{
+		mCommRange.removeTransmitter(&structure);
+	}
+}
+
+
+/**
+ * Gathers the colony wide values the structure update pass reads.
+ */
+void StructureManager::buildColonyContext()
+{
+	mColonyContext.chapAvailable = CHAPAvailable();
+}
+
+
+/**
+ * Structures whose storage holds the colony's refined resources.
+ */
+bool StructureManager::storesRefinedResources(const Structure* structure)
+{
+	return structure->structureClass() == Structure::StructureClass::Command ||
+		structure->structureClass() == Structure::StructureClass::Storage;
+}
+
+
 void StructureManager::update(const StorableResources& resources, PopulationPool& population)
 {
-	// Called separately so that 1) high priority structures can be updated first and
-	// 2) so that resource handling code (like energy) can be handled between update
-	// calls to lower priority structures.
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Lander]); // No resource needs
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Command]); // Self sufficient
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::EnergyProduction]); // Nothing can work without energy
-
-	updateEnergyProduction();
-
-	// Basic resource production
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Mine]); // Can't operate without resources.
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Smelter]);
-
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::LifeSupport]); // Air, water food must come before others
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::FoodProduction]);
-
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::MedicalCenter]); // No medical facilities, people die
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Nursery]);
-
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Factory]); // Production
-
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Storage]); // Everything else.
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Park]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::SurfacePolice]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::UndergroundPolice]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::RecreationCenter]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Recycling]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Residence]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::RobotCommand]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Warehouse]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Laboratory]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Commercial]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::University]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Communication]);
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Road]);
-
-	updateStructures(resources, population, mStructureLists[Structure::StructureClass::Undefined]);
+	buildColonyContext();
+
+	for (const auto& phase : UpdatePhases)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		updateStructures(resources, population, phase.structureClass, phase.thinkMode == ThinkMode::Parallel);
+
+		switch (phase.barrier)
+		{
+		case UpdateBarrier::EnergyProduction:
+			updateEnergyProduction();
+			break;
+
+		case UpdateBarrier::ChapAvailability:
+			mColonyContext.chapAvailable = CHAPAvailable();
+			break;
+
+		case UpdateBarrier::None:
+			break;
+		}
+
+		mUpdateTimes[static_cast<std::size_t>(phase.structureClass)] = std::chrono::steady_clock::now() - start;
+	}
 
 	assignColonistsToResidences(population);
 }
@@ -86,7 +234,7 @@ void StructureManager::updateEnergyProduction()
 	mTotalEnergyOutput = 0;
 	mTotalEnergyUsed = 0;
 
-	for (auto structure : mStructureLists[Structure::StructureClass::EnergyProduction])
+	for (auto structure : classList(Structure::StructureClass::EnergyProduction))
 	{
 		auto powerStructure = static_cast<PowerStructure*>(structure);
 		if (powerStructure->operational())
@@ -105,9 +253,9 @@ void StructureManager::updateEnergyConsumed()
 {
 	mTotalEnergyUsed = 0;
 
-	for (auto structureList : mStructureLists)
+	for (const auto& structureList : mStructureLists)
 	{
-		for (auto structure : structureList.second)
+		for (auto structure : structureList)
 		{
 			if (structure->operational() || structure->isIdle())
 			{
@@ -121,7 +269,7 @@ void StructureManager::updateEnergyConsumed()
 void StructureManager::assignColonistsToResidences(PopulationPool& population)
 {
 	int populationCount = population.size();
-	for (auto structure : mStructureLists[Structure::StructureClass::Residence])
+	for (auto structure : classList(Structure::StructureClass::Residence))
 	{
 		Residence* residence = static_cast<Residence*>(structure);
 		if (residence->operational())
@@ -133,38 +281,73 @@ void StructureManager::assignColonistsToResidences(PopulationPool& population)
 }
 
 
-void StructureManager::updateStructures(const StorableResources& resources, PopulationPool& population, StructureList& structures)
+/**
+ * Updates the structures of one class.
+ *
+ * Each structure is aged, then checked against colony wide requirements
+ * and charged for population, energy and resources in list order. The
+ * checks read the StructureComponents columns through the class's handle
+ * list. Structures that pass get to think(). When \c parallelThink is set
+ * those think() calls are held until the whole list has been charged and
+ * are then run in parallel, followed by commitThink() in list order.
+ */
+void StructureManager::updateStructures(const StorableResources& resources, PopulationPool& population, Structure::StructureClass structureClass, bool parallelThink)
 {
-	Structure* structure = nullptr;
+	mThinkList.clear();
+
+	// Indexed every pass, structures can be added to this class (and the
+	// columns can grow) while the list is being walked.
+	auto& structures = classList(structureClass);
+	const auto& handles = mClassHandles[static_cast<std::size_t>(structureClass)];
+	auto& components = NAS2D::Utility<StructureComponents>::get();
+
 	for (std::size_t i = 0; i < structures.size(); ++i)
 	{
-		structure = structures[i];
-		structure->update();
+		const auto handle = handles[i];
+		Structure* structure = structures[i];
+
+		// Aging
+		if (components.state[handle] != StructureState::Disabled && components.state[handle] != StructureState::Destroyed)
+		{
+			switch (components.incrementAge(handle))
+			{
+			case StructureComponents::AgeStep::Built:
+				structure->activate();
+				break;
+
+			case StructureComponents::AgeStep::WornOut:
+				structure->destroy();
+				break;
+
+			case StructureComponents::AgeStep::None:
+				break;
+			}
+		}
 
 		// State Check
 		// ASSUMPTION:	Construction sites are considered self sufficient until they are
 		//				completed and connected to the rest of the colony.
-		if (structure->underConstruction() || structure->destroyed())
+		if (components.state[handle] == StructureState::UnderConstruction || components.state[handle] == StructureState::Destroyed)
 		{
 			continue;
 		}
 
 		// Connection Check
-		if (!structureConnected(structure) && !structure->selfSustained())
+		if (!components.selfSustained[handle] && !structureConnected(structure))
 		{
 			structure->disable(DisabledReason::Disconnected);
 			continue;
 		}
 
 		// CHAP Check
-		if (structure->requiresCHAP() && !CHAPAvailable())
+		if (components.requiresChap[handle] && !mColonyContext.chapAvailable)
 		{
 			structure->disable(DisabledReason::Chap);
 			continue;
 		}
 
 		// Population Check
-		const auto& populationRequired = structure->populationRequirements();
+		const auto populationRequired = components.populationRequired[handle];
 		auto& populationAvailable = structure->populationAvailable();
 
 		fillPopulationRequirements(population, populationRequired, populationAvailable);
@@ -176,14 +359,14 @@ void StructureManager::updateStructures(const StorableResources& resources, Popu
 			continue;
 		}
 
-		if (structure->energyRequirement() > totalEnergyAvailable())
+		if (components.energyRequired[handle] > totalEnergyAvailable())
 		{
 			structure->disable(DisabledReason::Energy);
 			continue;
 		}
 
 		// Check that enough resources are available for input.
-		if (!structure->isIdle() && !(resources >= structure->resourcesIn()))
+		if (components.state[handle] != StructureState::Idle && !(resources >= components.resourcesIn[handle]))
 		{
 			structure->disable(DisabledReason::RefinedResources);
 			continue;
@@ -191,18 +374,102 @@ void StructureManager::updateStructures(const StorableResources& resources, Popu
 
 		structure->enable();
 
-		if (structure->operational() || structure->isIdle())
+		if (components.state[handle] == StructureState::Operational || components.state[handle] == StructureState::Idle)
 		{
 			population.usePopulation(Population::PersonRole::ROLE_WORKER, populationRequired[0]);
 			population.usePopulation(Population::PersonRole::ROLE_SCIENTIST, populationRequired[1]);
 
-			auto consumed = structure->resourcesIn();
-			removeRefinedResources(consumed);
+			auto consumed = components.resourcesIn[handle];
+			mResourceLedger.withdraw(consumed);
+
+			mTotalEnergyUsed += components.energyRequired[handle];
+
+			if (parallelThink)
+			{
+				mThinkList.push_back(structure);
+			}
+			else
+			{
+				structure->think();
+				structure->commitThink();
+			}
+		}
+	}
 
-			mTotalEnergyUsed += structure->energyRequirement();
+	if (parallelThink && !mThinkList.empty())
+	{
+		thinkInParallel(mThinkList);
 
+		for (auto thinker : mThinkList)
+		{
+			thinker->commitThink();
+		}
+	}
+}
+
+
+/**
+ * Runs think() for a list of structures in fixed size chunks across the
+ * WorkerPool.
+ *
+ * Structure signals are held while workers run so no listener is called
+ * off the main thread. The counts and transmitters for the class are
+ * rebuilt once every chunk has finished.
+ */
+void StructureManager::thinkInParallel(StructureList& structures)
+{
+	const std::size_t chunkCount = (structures.size() + ThinkChunkSize - 1) / ThinkChunkSize;
+	if (chunkCount < 2)
+	{
+		for (auto structure : structures)
+		{
 			structure->think();
 		}
+		return;
+	}
+
+	Structure::holdSignals(true);
+
+	try
+	{
+		NAS2D::Utility<WorkerPool>::get().run(chunkCount, [&structures](std::size_t chunk, std::size_t)
+		{
+			const auto end = std::min(structures.size(), (chunk + 1) * ThinkChunkSize);
+			for (auto i = chunk * ThinkChunkSize; i < end; ++i)
+			{
+				structures[i]->think();
+			}
+		});
+	}
+	catch (...)
+	{
+		Structure::holdSignals(false);
+		resyncClass(structures.front()->structureClass());
+		throw;
+	}
+
+	Structure::holdSignals(false);
+	resyncClass(structures.front()->structureClass());
+}
+
+
+/**
+ * Rebuilds the state counts and transmitters for one class from its
+ * structures.
+ */
+void StructureManager::resyncClass(Structure::StructureClass structureClass)
+{
+	auto& counts = mStateCounts[static_cast<std::size_t>(structureClass)];
+	for (std::size_t state = 0; state < counts.size(); ++state)
+	{
+		mStateTotals[state] -= counts[state];
+		counts[state] = 0;
+	}
+
+	for (auto structure : classList(structureClass))
+	{
+		countState(*structure, 1);
+		updateTransmitter(*structure);
 	}
 }
 
@@ -218,7 +485,7 @@ void StructureManager::addStructure(Structure* structure, Tile* tile)
 		return;
 	}
 
-	if (mStructureTileTable.find(structure) != mStructureTileTable.end())
+	if (structure->mTile != nullptr)
 	{
 		throw std::runtime_error("StructureManager::addStructure(): Attempting to add a Structure that is already managed!");
 	}
@@ -229,9 +496,25 @@ void StructureManager::addStructure(Structure* structure, Tile* tile)
 		tile->removeThing();
 	}
 
-	mStructureTileTable[structure] = tile;
+	auto& structureList = classList(structure->structureClass());
+	structure->mTile = tile;
+	structure->mListIndex = structureList.size();
+	structureList.push_back(structure);
+	mClassHandles[static_cast<std::size_t>(structure->structureClass())].push_back(structure->mHandle);
+	countState(*structure, 1);
+
+	if (storesRefinedResources(structure))
+	{
+		mResourceLedger.addTank(structure);
+	}
+
+	if (structure->isWarehouse())
+	{
+		mWarehouseIndex.addWarehouse(static_cast<Warehouse*>(structure));
+	}
+
+	updateTransmitter(*structure);
 
-	mStructureLists[structure->structureClass()].push_back(structure);
 	tile->pushThing(structure);
 }
 
@@ -239,55 +522,51 @@ void StructureManager::addStructure(Structure* structure, Tile* tile)
 /**
  * Removes a Structure from the StructureManager.
  *
+ * The last Structure of the same class is moved into the vacated
+ * slot so removal doesn't shift the rest of the list.
+ *
  * \warning	A Structure removed from the StructureManager will be freed.
  *			Remaining pointers and references will be invalidated.
  */
 void StructureManager::removeStructure(Structure* structure)
 {
-	StructureList& structures = mStructureLists[structure->structureClass()];
+	auto& structureList = classList(structure->structureClass());
+	const auto index = structure->mListIndex;
 
-	if (structures.empty())
+	if (structure->mTile == nullptr || index >= structureList.size() || structureList[index] != structure)
 	{
 		throw std::runtime_error("StructureManager::removeStructure(): Attempting to remove a Structure that is not managed by the StructureManager.");
 	}
 
-	for (std::size_t i = 0; i < structures.size(); ++i)
-	{
-		if (structures[i] == structure)
-		{
-			structures.erase(structures.begin() + static_cast<std::ptrdiff_t>(i));
-			break;
-		}
-	}
+	auto& handles = mClassHandles[static_cast<std::size_t>(structure->structureClass())];
+	structureList[index] = structureList.back();
+	structureList[index]->mListIndex = index;
+	structureList.pop_back();
+	handles[index] = handles.back();
+	handles.pop_back();
+	countState(*structure, -1);
 
-	auto tileTableIt = mStructureTileTable.find(structure);
-	if (tileTableIt == mStructureTileTable.end())
+	if (storesRefinedResources(structure))
 	{
-		throw std::runtime_error("StructureManager::removeStructure(): Attempting to remove a Structure that is not managed by the StructureManager.");
+		mResourceLedger.removeTank(structure);
 	}
-	else
+
+	if (structure->isWarehouse())
 	{
-		tileTableIt->second->deleteThing();
-		mStructureTileTable.erase(tileTableIt);
+		mWarehouseIndex.removeWarehouse(static_cast<Warehouse*>(structure));
 	}
-}
 
+	mCommRange.removeTransmitter(structure);
 
-const StructureList& StructureManager::structureList(Structure::StructureClass structureClass)
-{
-	return mStructureLists[structureClass];
+	Tile* tile = structure->mTile;
+	structure->mTile = nullptr;
+	tile->deleteThing();
 }
 
 
-/**
- * Resets the 'connected' flag on all structures in the primary structure list.
- */
-void StructureManager::disconnectAll()
+const StructureList& StructureManager::structureList(Structure::StructureClass structureClass)
 {
-	for (auto st_it = mStructureTileTable.begin(); st_it != mStructureTileTable.end(); ++st_it)
-	{
-		st_it->second->connected(false);
-	}
+	return classList(structureClass);
 }
 
 
@@ -297,79 +576,117 @@ void StructureManager::disconnectAll()
 int StructureManager::count() const
 {
 	int count = 0;
-	for (auto it = mStructureLists.begin(); it != mStructureLists.end(); ++it)
+	for (auto stateCount : mStateTotals)
 	{
-		count += static_cast<int>(it->second.size());
+		count += stateCount;
 	}
 
 	return count;
 }
 
 
-int StructureManager::getCountInState(Structure::StructureClass structureClass, StructureState state)
+int StructureManager::getCountInState(Structure::StructureClass structureClass, StructureState state) const
 {
-	int count = 0;
-	for (const auto* structure : structureList(structureClass))
-	{
-		if (structure->state() == state)
-		{
-			++count;
-		}
-	}
-	return count;
+	return mStateCounts[static_cast<std::size_t>(structureClass)][static_cast<std::size_t>(state)];
 }
 
 
 /**
  * Gets a count of the number of disabled buildings.
  */
-int StructureManager::disabled()
+int StructureManager::disabled() const
 {
-	int count = 0;
-	for (auto it = mStructureLists.begin(); it != mStructureLists.end(); ++it)
-	{
-		count += getCountInState(it->first, StructureState::Disabled);
-	}
-
-	return count;
+	return mStateTotals[static_cast<std::size_t>(StructureState::Disabled)];
 }
 
 
 /**
  * Gets a count of the number of destroyed buildings.
  */
-int StructureManager::destroyed()
+int StructureManager::destroyed() const
 {
-	int count = 0;
-	for (auto it = mStructureLists.begin(); it != mStructureLists.end(); ++it)
+	return mStateTotals[static_cast<std::size_t>(StructureState::Destroyed)];
+}
+
+
+/**
+ * Adds \c delta to the counters for the class and current state of a Structure.
+ */
+void StructureManager::countState(const Structure& structure, int delta)
+{
+	const auto state = static_cast<std::size_t>(structure.state());
+	mStateCounts[static_cast<std::size_t>(structure.structureClass())][state] += delta;
+	mStateTotals[state] += delta;
+}
+
+
+/**
+ * Moves a managed Structure from its old state counter to its new one.
+ *
+ * \note	Structures that aren't managed yet (e.g., being set up by the
+ *			StructureCatalogue) are counted when they're added.
+ */
+void StructureManager::onStructureStateChanged(const Structure& structure, StructureState oldState)
+{
+	checkMainThread("StructureManager::onStructureStateChanged()");
+	if (structure.mTile == nullptr) { return; }
+
+	const auto structureClass = static_cast<std::size_t>(structure.structureClass());
+	mStateCounts[structureClass][static_cast<std::size_t>(oldState)] -= 1;
+	mStateTotals[static_cast<std::size_t>(oldState)] -= 1;
+	countState(structure, 1);
+
+	updateTransmitter(structure);
+}
+
+
+/**
+ * Structure signals must only be raised on the main thread. The state
+ * counts aren't guarded so a handler running on a worker would race.
+ */
+void StructureManager::checkMainThread(const std::string& caller) const
+{
+	if (std::this_thread::get_id() != mMainThread)
 	{
-		count += getCountInState(it->first, StructureState::Destroyed);
+		throw std::runtime_error(caller + ": Structure signal raised off the main thread");
 	}
-
-	return count;
 }
 
 
 void StructureManager::dropAllStructures()
 {
-	for (auto map_it = mStructureTileTable.begin(); map_it != mStructureTileTable.end(); ++map_it)
+	for (auto& structureList : mStructureLists)
 	{
-		map_it->second->deleteThing();
+		for (auto structure : structureList)
+		{
+			Tile* tile = structure->mTile;
+			structure->mTile = nullptr;
+			tile->deleteThing();
+		}
+
+		structureList.clear();
+	}
+
+	for (auto& handles : mClassHandles)
+	{
+		handles.clear();
 	}
 
-	mStructureTileTable.clear();
-	mStructureLists.clear();
+	mStateCounts = {};
+	mStateTotals = {};
+	mResourceLedger.clear();
+	mWarehouseIndex.clear();
+	mCommRange.clear();
 }
 
 
 Tile& StructureManager::tileFromStructure(Structure* structure)
 {
-	auto it = mStructureTileTable.find(structure);
-	if (it == mStructureTileTable.end())
+	if (structure->mTile == nullptr)
 	{
 		throw std::runtime_error("Could not find tile for structure");
 	}
-	return *it->second;
+	return *structure->mTile;
 }
 
 
@@ -409,59 +726,64 @@ void StructureManager::serialize(NAS2D::Xml::XmlElement* element)
 {
 	auto* structures = new NAS2D::Xml::XmlElement("structures");
 
-	for (auto& [structure, tile] : mStructureTileTable)
-	{
-		auto* structureElement = new NAS2D::Xml::XmlElement("structure");
-		serializeStructure(structureElement, structure, tile);
-
-		if (structure->isFactory())
-		{
-			structureElement->attribute("production_completed", static_cast<Factory*>(structure)->productionTurnsCompleted());
-			structureElement->attribute("production_type", static_cast<Factory*>(structure)->productType());
-		}
+	mResourceLedger.distribute();
 
-		if (structure->isWarehouse())
+	for (const auto& structureList : mStructureLists)
+	{
+		for (auto structure : structureList)
 		{
-			auto* warehouse_products = new NAS2D::Xml::XmlElement("warehouse_products");
-			static_cast<Warehouse*>(structure)->products().serialize(warehouse_products);
-			structureElement->linkEndChild(warehouse_products);
-		}
+			auto* structureElement = new NAS2D::Xml::XmlElement("structure");
+			serializeStructure(structureElement, structure, structure->mTile);
 
-		if (structure->isRobotCommand())
-		{
-			auto* robotsElement = new NAS2D::Xml::XmlElement("robots");
+			if (structure->isFactory())
+			{
+				structureElement->attribute("production_completed", static_cast<Factory*>(structure)->productionTurnsCompleted());
+				structureElement->attribute("production_type", static_cast<Factory*>(structure)->productType());
+			}
 
-			const auto& robots = static_cast<RobotCommand*>(structure)->robots();
+			if (structure->isWarehouse())
+			{
+				auto* warehouse_products = new NAS2D::Xml::XmlElement("warehouse_products");
+				static_cast<Warehouse*>(structure)->products().serialize(warehouse_products);
+				structureElement->linkEndChild(warehouse_products);
+			}
 
-			std::stringstream str;
-			for (std::size_t i = 0; i < robots.size(); ++i)
+			if (structure->isRobotCommand())
 			{
-				str << robots[i]->id();
-				if (i != robots.size() - 1) { str << ","; } // kind of a kludge
+				auto* robotsElement = new NAS2D::Xml::XmlElement("robots");
+
+				const auto& robots = static_cast<RobotCommand*>(structure)->robots();
+
+				std::stringstream str;
+				for (std::size_t i = 0; i < robots.size(); ++i)
+				{
+					str << robots[i]->id();
+					if (i != robots.size() - 1) { str << ","; } // kind of a kludge
+				}
+
+				robotsElement->attribute("robots", str.str());
+				structureElement->linkEndChild(robotsElement);
 			}
 
-			robotsElement->attribute("robots", str.str());
-			structureElement->linkEndChild(robotsElement);
-		}
+			if (structure->structureClass() == Structure::StructureClass::FoodProduction ||
+				structure->structureId() == StructureID::SID_COMMAND_CENTER)
+			{
+				auto* food = new NAS2D::Xml::XmlElement("food");
+				food->attribute("level", static_cast<FoodProduction*>(structure)->foodLevel());
+				structureElement->linkEndChild(food);
+			}
 
-		if (structure->structureClass() == Structure::StructureClass::FoodProduction ||
-			structure->structureId() == StructureID::SID_COMMAND_CENTER)
-		{
-			auto* food = new NAS2D::Xml::XmlElement("food");
-			food->attribute("level", static_cast<FoodProduction*>(structure)->foodLevel());
-			structureElement->linkEndChild(food);
-		}
+			if (structure->structureClass() == Structure::StructureClass::Residence)
+			{
+				Residence* residence = static_cast<Residence*>(structure);
+				auto* waste = new NAS2D::Xml::XmlElement("waste");
+				waste->attribute("accumulated", residence->wasteAccumulated());
+				waste->attribute("overflow", residence->wasteOverflow());
+				structureElement->linkEndChild(waste);
+			}
 
-		if (structure->structureClass() == Structure::StructureClass::Residence)
-		{
-			Residence* residence = static_cast<Residence*>(structure);
-			auto* waste = new NAS2D::Xml::XmlElement("waste");
-			waste->attribute("accumulated", residence->wasteAccumulated());
-			waste->attribute("overflow", residence->wasteOverflow());
-			structureElement->linkEndChild(waste);
+			structures->linkEndChild(structureElement);
 		}
-
-		structures->linkEndChild(structureElement);
 	}
 
 	element->linkEndChild(structures);
@@ -470,5 +792,5 @@ void StructureManager::serialize(NAS2D::Xml::XmlElement* element)
 
 bool StructureManager::structureConnected(Structure* structure)
 {
-	return mStructureTileTable[structure]->connected();
+	return structure->mTile->connected();
 }
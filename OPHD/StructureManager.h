@@ -1,7 +1,17 @@
 #pragma once
 
+#include "ResourceLedger.h"
+#include "Map/CommRangeGrid.h"
+#include "WarehouseIndex.h"
+
 #include "Things/Structures/Structure.h"
 
+#include <array>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
 
 namespace NAS2D {
 	namespace Xml {
@@ -22,21 +32,26 @@ struct StorableResources;
 class StructureManager
 {
 public:
+	StructureManager();
+	~StructureManager();
+
 	void addStructure(Structure* structure, Tile* tile);
 	void removeStructure(Structure* structure);
 
 	const StructureList& structureList(Structure::StructureClass structureClass);
+	ResourceLedger& resourceLedger() { return mResourceLedger; }
+	const WarehouseIndex& warehouseIndex() const { return mWarehouseIndex; }
+	CommRangeGrid& commRangeGrid() { return mCommRange; }
 	Tile& tileFromStructure(Structure* structure);
 
-	void disconnectAll();
 	void dropAllStructures();
 
 	int count() const;
 
-	int getCountInState(Structure::StructureClass structureClass, StructureState state);
+	int getCountInState(Structure::StructureClass structureClass, StructureState state) const;
 
-	int disabled();
-	int destroyed();
+	int disabled() const;
+	int destroyed() const;
 
 	bool CHAPAvailable();
 
@@ -50,18 +65,59 @@ public:
 
 	void update(const StorableResources&, PopulationPool&);
 
+	using UpdateTimes = std::array<std::chrono::steady_clock::duration, Structure::StructureClassCount>;
+
+	/**
+	 * Time spent updating each StructureClass during the last update(),
+	 * including any barrier work that follows it. Indexed by StructureClass.
+	 */
+	const UpdateTimes& updateTimes() const { return mUpdateTimes; }
+
 	void serialize(NAS2D::Xml::XmlElement* element);
 
 private:
-	using StructureTileTable = std::map<Structure*, Tile*>;
-	using StructureClassTable = std::map<Structure::StructureClass, StructureList>;
+	using StructureClassTable = std::array<StructureList, Structure::StructureClassCount>;
+	using StateCountTable = std::array<std::array<int, StructureStateCount>, Structure::StructureClassCount>;
+
+	StructureList& classList(Structure::StructureClass structureClass) { return mStructureLists[static_cast<std::size_t>(structureClass)]; }
+
+	void updateStructures(const StorableResources&, PopulationPool&, Structure::StructureClass, bool parallelThink);
+	void thinkInParallel(StructureList& structures);
+	void resyncClass(Structure::StructureClass structureClass);
+
+	void buildColonyContext();
 
-	void updateStructures(const StorableResources&, PopulationPool&, StructureList&);
+	static bool storesRefinedResources(const Structure* structure);
+	static int transmitterRange(const Structure& structure);
+	void updateTransmitter(const Structure& structure);
 
 	bool structureConnected(Structure* structure);
 
-	StructureTileTable mStructureTileTable; /**< List mapping Structures to a particular tile. */
-	StructureClassTable mStructureLists; /**< Map containing all of the structure list types available. */
+	void countState(const Structure& structure, int delta);
+	void onStructureStateChanged(const Structure& structure, StructureState oldState);
+	void checkMainThread(const std::string& caller) const;
+
+	StructureClassTable mStructureLists; /**< Structure lists indexed by StructureClass. Each Structure knows its own slot and tile. */
+	/**
+	 * Colony wide values gathered once at the start of update() so the
+	 * structure update pass doesn't have to rescan structure lists.
+	 */
+	struct ColonyContext
+	{
+		bool chapAvailable = false; /**< At least one operational life support facility. */
+	};
+
+	ColonyContext mColonyContext;
+	ResourceLedger mResourceLedger; /**< Refined resources held by the Command Center and storage tanks. */
+	WarehouseIndex mWarehouseIndex; /**< Warehouses ordered by available product storage. */
+	CommRangeGrid mCommRange; /**< Communications coverage of operational Command Centers and Communications Towers. */
+	UpdateTimes mUpdateTimes{}; /**< Per class timing of the last update(). */
+
+	StructureList mThinkList; /**< Structures cleared to think() during the current phase. */
+	std::thread::id mMainThread; /**< Thread the StructureManager was created on, the only one Structure signals may be raised on. */
+	std::array<std::vector<StructureComponents::Handle>, Structure::StructureClassCount> mClassHandles; /**< StructureComponents handles of each class list, slot for slot. */
+	StateCountTable mStateCounts{}; /**< Number of managed structures in each StructureClass and StructureState. */
+	std::array<int, StructureStateCount> mStateTotals{}; /**< Number of managed structures in each StructureState. */
 
 	int mTotalEnergyOutput = 0; /**< Total energy output of all energy producers in the structure list. */
 	int mTotalEnergyUsed = 0;
@@ -1,5 +1,8 @@
 #include "Robot.h"
 
+#include "../Structures/RobotCommand.h"
+
+
 Robot::Robot(const std::string& name, const std::string& sprite_path, Type t) :
 	Thing(name, sprite_path, "running"),
 	mType{ t }
@@ -12,6 +15,19 @@ Robot::Robot(const std::string& name, const std::string& sprite_path, const std:
 {}
 
 
+/**
+ * A robot that is destroyed is released from the Robot Command facility
+ * controlling it.
+ */
+Robot::~Robot()
+{
+	if (mCommand != nullptr)
+	{
+		mCommand->removeRobot(this);
+	}
+}
+
+
 void Robot::startTask(int turns)
 {
 	if (turns < 1) { throw std::runtime_error("Robot::startTask() called with a value less than 1."); }
@@ -2,6 +2,10 @@
 
 #include "../Thing.h"
 
+#include <cstddef>
+
+
+class RobotCommand;
 
 class Robot: public Thing
 {
@@ -20,6 +24,7 @@ public:
 public:
 	Robot(const std::string&, const std::string&, Type);
 	Robot(const std::string&, const std::string&, const std::string&, Type);
+	~Robot() override;
 
 	void startTask(int turns);
 
@@ -47,6 +52,10 @@ protected:
 	void updateTask();
 
 private:
+	friend class RobotPool;
+	friend class RobotCommand;
+	friend class RobotTaskTable;
+
 	int mId = 0;
 	int mFuelCellAge = 0;
 	int mTurnsToCompleteTask = 0;
@@ -57,4 +66,12 @@ private:
 	Type mType{ Type::None };
 
 	TaskCallback mTaskCompleteCallback;
+
+	std::size_t mPoolIndex = 0; /**< Slot in the RobotPool list for this robot's type. */
+	std::size_t mRobotsIndex = 0; /**< Slot in the RobotPool list of all robots. */
+
+	RobotCommand* mCommand = nullptr; /**< Robot Command facility controlling this robot, if any. */
+	std::size_t mCommandIndex = 0; /**< Slot in the controlling Robot Command facility's list. */
+
+	std::size_t mTaskIndex = 0; /**< Slot in the RobotTaskTable while deployed. */
 };
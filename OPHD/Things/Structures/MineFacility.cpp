@@ -54,7 +54,7 @@ void MineFacility::think()
 		if (mDigTurnsRemaining == 0)
 		{
 			mMine->increaseDepth();
-			mExtensionComplete(this);
+			mExtensionPending = true;
 		}
 
 		return;
@@ -119,6 +119,15 @@ void MineFacility::think()
 }
 
 
+void MineFacility::commitThink()
+{
+	if (!mExtensionPending) { return; }
+
+	mExtensionPending = false;
+	mExtensionComplete(this);
+}
+
+
 bool MineFacility::canExtend() const
 {
 	return (mMine->depth() < mMaxDepth) && (mDigTurnsRemaining == 0);
@@ -38,6 +38,7 @@ public:
 
 protected:
 	void think() override;
+	void commitThink() override;
 
 private:
 	MineFacility() = delete;
@@ -53,6 +54,8 @@ private:
 	int mAssignedTrucks = 1; /**< All mine facilities are built with at least one truck. */
 	int mMaxTruckCount = 10;
 
+	bool mExtensionPending = false; /**< Extension finished during think(), signal is raised from commitThink(). */
+
 	Mine* mMine = nullptr; /**< Mine that this facility manages. */
 
 	ExtensionCompleteCallback mExtensionComplete; /**< Called whenever an extension is completed. */
@@ -8,6 +8,19 @@
 #include <algorithm>
 
 
+/**
+ * Robots still listed are released so they don't refer back to a
+ * facility that no longer exists.
+ */
+RobotCommand::~RobotCommand()
+{
+	for (auto robot : mRobotList)
+	{
+		robot->mCommand = nullptr;
+	}
+}
+
+
 /**
  * Gets whether the command facility has additional command capacity remaining.
  */
@@ -22,7 +35,7 @@ bool RobotCommand::commandCapacityAvailable() const
  */
 bool RobotCommand::isControlling(Robot* robot) const
 {
-	return find(mRobotList.begin(), mRobotList.end(), robot) != mRobotList.end();
+	return robot->mCommand == this;
 }
 
 
@@ -41,14 +54,30 @@ void RobotCommand::addRobot(Robot* robot)
 		throw std::runtime_error("RobotCommand::addRobot(): Adding a robot that is already under the command of this Robot Command Facility. Robot name: " + robot->name());
 	}
 
+	if (robot->mCommand != nullptr)
+	{
+		throw std::runtime_error("RobotCommand::addRobot(): Adding a robot that is already under the command of another Robot Command Facility. Robot name: " + robot->name());
+	}
+
+	robot->mCommand = this;
+	robot->mCommandIndex = mRobotList.size();
 	mRobotList.push_back(robot);
 }
 
 
 /**
  * Removes a robot from the management pool of the Robot Command structure.
+ *
+ * \note	The last robot in the list takes the removed robot's place.
  */
 void RobotCommand::removeRobot(Robot* robot)
 {
-	mRobotList.erase(std::remove(mRobotList.begin(), mRobotList.end(), robot), mRobotList.end());
+	if (!isControlling(robot)) { return; }
+
+	auto* last = mRobotList.back();
+	mRobotList[robot->mCommandIndex] = last;
+	last->mCommandIndex = robot->mCommandIndex;
+	mRobotList.pop_back();
+
+	robot->mCommand = nullptr;
 }
@@ -26,6 +26,8 @@ public:
 		requiresCHAP(false);
 	}
 
+	~RobotCommand() override;
+
 	bool isControlling(Robot* robot) const;
 
 	bool commandCapacityAvailable() const;
@@ -3,6 +3,12 @@
 #include "../../Constants.h"
 
 
+namespace
+{
+	bool signalsHeld = false;
+}
+
+
 /**
  * Translation table for Structure States.
  */
@@ -99,12 +105,39 @@ std::string StructureName(StructureID id)
 
 
 
+/**
+ * Signal raised whenever a structure's state changes. Passes the
+ * structure and the state it left.
+ *
+ * \note	Shared by all structures so the StructureManager can keep its
+ *			per state counts current without polling.
+ */
+Structure::StateChangeSignal& Structure::stateChanged()
+{
+	static StateChangeSignal signal;
+	return signal;
+}
+
+
+/**
+ * Stops stateChanged() from being raised while set.
+ *
+ * \note	Held by the StructureManager while structures think on worker
+ *			threads so listeners are only ever called from the main thread.
+ *			Anything listening has to rebuild what it tracks once released.
+ */
+void Structure::holdSignals(bool hold)
+{
+	signalsHeld = hold;
+}
+
+
 Structure::Structure(const std::string& name, const std::string& spritePath, StructureClass structureClass, StructureID id) :
 	Thing(name, spritePath, constants::STRUCTURE_STATE_CONSTRUCTION),
 	mStructureId(id),
-	mStructureClass(structureClass)
+	mStructureClass(structureClass),
+	mHandle(components().create())
 {
-	mPopulationRequirements.fill(0);
 	mPopulationAvailable.fill(0);
 }
 
@@ -112,9 +145,9 @@ Structure::Structure(const std::string& name, const std::string& spritePath, Str
 Structure::Structure(const std::string& name, const std::string& spritePath, const std::string& initialAction, StructureClass structureClass, StructureID id) :
 	Thing(name, spritePath, initialAction),
 	mStructureId(id),
-	mStructureClass(structureClass)
+	mStructureClass(structureClass),
+	mHandle(components().create())
 {
-	mPopulationRequirements.fill(0);
 	mPopulationAvailable.fill(0);
 }
 
@@ -192,6 +225,24 @@ void Structure::forceIdle(bool force)
 	}
 }
 
+Structure::~Structure()
+{
+	components().destroy(mHandle);
+}
+
+
+void Structure::state(StructureState newState)
+{
+	auto& structureState = components().state[mHandle];
+	if (newState == structureState) { return; }
+
+	const auto oldState = structureState;
+	structureState = newState;
+	if (signalsHeld) { return; }
+	stateChanged()(*this, oldState);
+}
+
+
 const std::string& Structure::stateDescription() const
 {
 	return stateDescription(state());
@@ -242,15 +293,18 @@ void Structure::update()
  */
 void Structure::incrementAge()
 {
-	mAge++;
-
-	if (age() == turnsToBuild())
+	switch (components().incrementAge(mHandle))
 	{
+	case StructureComponents::AgeStep::Built:
 		activate();
-	}
-	else if (age() == maxAge())
-	{
+		break;
+
+	case StructureComponents::AgeStep::WornOut:
 		destroy();
+		break;
+
+	case StructureComponents::AgeStep::None:
+		break;
 	}
 }
 
@@ -287,7 +341,7 @@ void Structure::forced_state_change(StructureState structureState, DisabledReaso
 	else if (structureState == StructureState::Idle) { idle(idleReason); }
 	else if (structureState == StructureState::Disabled) { disable(disabledReason); }
 	else if (structureState == StructureState::Destroyed) { destroy(); }
-	else if (structureState == StructureState::UnderConstruction) { mStructureState = StructureState::UnderConstruction; } // Kludge
+	else if (structureState == StructureState::UnderConstruction) { state(StructureState::UnderConstruction); } // Kludge
 }
 
 
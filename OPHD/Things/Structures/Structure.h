@@ -1,11 +1,21 @@
 #pragma once
 
+#include "StructureComponents.h"
+
 #include "../Thing.h"
 
 #include "../../Common.h"
 #include "../../StorableResources.h"
 #include "../../UI/StringTable.h"
 
+#include <NAS2D/Utility.h>
+
+#include <cstddef>
+
+
+class Tile;
+
+
 /**
  * State of an individual Structure.
  */
@@ -18,6 +28,10 @@ enum class StructureState
 	Destroyed
 };
 
+/** Number of entries in StructureState. */
+constexpr std::size_t StructureStateCount = static_cast<std::size_t>(StructureState::Destroyed) + 1;
+
+
 class Structure : public Thing
 {
 public:
@@ -61,43 +75,53 @@ public:
 		Warehouse
 	};
 
+	/** Number of entries in StructureClass. */
+	static constexpr std::size_t StructureClassCount = static_cast<std::size_t>(StructureClass::Warehouse) + 1;
+
+	using StateChangeSignal = NAS2D::Signals::Signal<const Structure&, StructureState>;
+
 public:
+	static StateChangeSignal& stateChanged();
+	static void holdSignals(bool hold);
+
 	Structure(const std::string& name, const std::string& spritePath, StructureClass structureClass, StructureID id);
 	Structure(const std::string& name, const std::string& spritePath, const std::string& initialAction, StructureClass structureClass, StructureID id);
+	Structure(const Structure&) = delete;
+	Structure& operator=(const Structure&) = delete;
 
-	~Structure() override = default;
+	~Structure() override;
 
 	// STATES & STATE MANAGEMENT
-	StructureState state() const { return mStructureState; }
+	StructureState state() const { return components().state[mHandle]; }
 
 	StructureID structureId() const { return mStructureId; }
 
-	bool disabled() const { return mStructureState == StructureState::Disabled; }
+	bool disabled() const { return state() == StructureState::Disabled; }
 	void disable(DisabledReason);
 	DisabledReason disabledReason() const { return mDisabledReason; }
 
-	bool operational() const { return mStructureState == StructureState::Operational; }
+	bool operational() const { return state() == StructureState::Operational; }
 	void enable();
 
-	bool isIdle() const { return mStructureState == StructureState::Idle; }
+	bool isIdle() const { return state() == StructureState::Idle; }
 	void idle(IdleReason);
 	IdleReason idleReason() const { return mIdleReason; }
 
-	bool destroyed() const { return mStructureState == StructureState::Destroyed; }
+	bool destroyed() const { return state() == StructureState::Destroyed; }
 	void destroy();
 
-	bool underConstruction() const { return mStructureState == StructureState::UnderConstruction; }
+	bool underConstruction() const { return state() == StructureState::UnderConstruction; }
 
 	void forceIdle(bool force);
 	bool forceIdle() const { return mForcedIdle; }
 
 	// RESOURCES AND RESOURCE MANAGEMENT
-	const StorableResources& resourcesIn() const { return mResourcesInput; }
+	const StorableResources& resourcesIn() const { return components().resourcesIn[mHandle]; }
 
 	StorableResources& storage() { return mStoragePool; }
 	StorableResources& production() { return mProductionPool; }
 
-	const PopulationRequirements& populationRequirements() const { return mPopulationRequirements; }
+	const PopulationRequirements& populationRequirements() const { return components().populationRequired[mHandle]; }
 	PopulationRequirements& populationAvailable() { return mPopulationAvailable; }
 
 	// ATTRIBUTES
@@ -108,17 +132,17 @@ public:
 	static const std::string& classDescription(Structure::StructureClass structureClass);
 	ConnectorDir connectorDirection() const { return mConnectorDirection; }
 
-	int turnsToBuild() const { return mTurnsToBuild; }
-	int age() const { return mAge; }
-	int maxAge() const { return mMaxAge; }
+	int turnsToBuild() const { return components().turnsToBuild[mHandle]; }
+	int age() const { return components().age[mHandle]; }
+	int maxAge() const { return components().maxAge[mHandle]; }
 	bool ages() const { return maxAge() > 0; }
-	int energyRequirement() const { return mEnergyRequirement; }
+	int energyRequirement() const { return components().energyRequired[mHandle]; }
 	int storageCapacity() const { return mStorageCapacity; }
 
 	// FLAGS
-	bool requiresCHAP() const { return mRequiresCHAP; }
+	bool requiresCHAP() const { return components().requiresChap[mHandle]; }
 	bool providesCHAP() const { return structureClass() == StructureClass::LifeSupport; }
-	bool selfSustained() const { return mSelfSustained; }
+	bool selfSustained() const { return components().selfSustained[mHandle]; }
 	bool repairable() const { return mRepairable; }
 
 	// CONVENIENCE FUCNTIONS
@@ -136,7 +160,7 @@ public:
 	 * \note	Available to reset current age to simulate repairs to extend
 	 *			the life of the Structure and for loading games.
 	 */
-	void age(int newAge) { mAge = newAge; }
+	void age(int newAge) { components().age[mHandle] = newAge; }
 	void connectorDirection(ConnectorDir dir) { mConnectorDirection = dir; }
 
 	virtual void forced_state_change(StructureState, DisabledReason, IdleReason);
@@ -144,6 +168,15 @@ public:
 	void update() override;
 	virtual void think() {}
 
+	/**
+	 * Called from the serial part of the update pass after think().
+	 *
+	 * \note	Some structure classes think() in parallel. Those structures
+	 *			must only touch their own state in think() and should raise
+	 *			signals or touch shared state from here instead.
+	 */
+	virtual void commitThink() {}
+
 	/**
 	* Pass limited structure specific details for drawing. Use a custom UI window if needed.
 	*/
@@ -151,9 +184,10 @@ public:
 
 protected:
 	friend class StructureCatalogue;
+	friend class StructureManager;
 
-	void turnsToBuild(int newTurnsToBuild) { mTurnsToBuild = newTurnsToBuild; }
-	void maxAge(int newMaxAge) { mMaxAge = newMaxAge; }
+	void turnsToBuild(int newTurnsToBuild) { components().turnsToBuild[mHandle] = newTurnsToBuild; }
+	void maxAge(int newMaxAge) { components().maxAge[mHandle] = newMaxAge; }
 
 	void repairable(bool isRepairable) { mRepairable = isRepairable; }
 
@@ -163,21 +197,23 @@ protected:
 
 	virtual void disabledStateSet() {}
 
-	void state(StructureState newState) { mStructureState = newState; }
+	void state(StructureState newState);
 
-	void requiresCHAP(bool value) { mRequiresCHAP = value; }
-	void selfSustained(bool value) { mSelfSustained = value; }
+	void requiresCHAP(bool value) { components().requiresChap[mHandle] = value; }
+	void selfSustained(bool value) { components().selfSustained[mHandle] = value; }
 
-	void setPopulationRequirements(const PopulationRequirements& pr) { mPopulationRequirements = pr; }
-	void energyRequired(int energy) { mEnergyRequirement = energy; }
+	void setPopulationRequirements(const PopulationRequirements& pr) { components().populationRequired[mHandle] = pr; }
+	void energyRequired(int energy) { components().energyRequired[mHandle] = energy; }
 
-	void resourcesIn(const StorableResources& resources) { mResourcesInput = resources; }
+	void resourcesIn(const StorableResources& resources) { components().resourcesIn[mHandle] = resources; }
 
 	void storageCapacity(int capacity) { mStorageCapacity = capacity; }
 
 private:
 	Structure() = delete;
 
+	static StructureComponents& components() { return NAS2D::Utility<StructureComponents>::get(); }
+
 	void incrementAge();
 	void die() override;
 
@@ -188,23 +224,15 @@ private:
 	virtual void activated() {}
 
 private:
-	int mTurnsToBuild = 0; /**< Number of turns it takes to build the Structure. */
-	int mAge = 0; /**< Age of the Structure in turns. */
-	int mMaxAge = 0; /**< Maximum number of turns the Structure can remain in good repair. */
-	int mEnergyRequirement = 0;
 	int mStorageCapacity = 0;
 
 	StructureID mStructureId{ StructureID::SID_NONE };
 
-	StructureState mStructureState = StructureState::UnderConstruction; /**< State the structure is in. */
 	StructureClass mStructureClass; /**< Indicates the Structure's Type. */
 	ConnectorDir mConnectorDirection = ConnectorDir::CONNECTOR_INTERSECTION; /**< Directions available for connections. */
 
-	PopulationRequirements mPopulationRequirements; /**< Population requirements for structure operation. */
 	PopulationRequirements mPopulationAvailable; /**< Determine how many of each type of population required was actually supplied to the structure. */
 
-	StorableResources mResourcesInput; /**< Resources needed to operate the Structure. */
-
 	StorableResources mProductionPool; /**< Resource pool used for production. */
 	StorableResources mStoragePool; /**< Resource storage pool. */
 
@@ -212,9 +240,11 @@ private:
 	IdleReason mIdleReason = IdleReason::None;
 
 	bool mRepairable = true; /**< Indicates whether or not the Structure can be repaired. Useful for forcing some Structures to die at the end of their life. */
-	bool mRequiresCHAP = true; /**< Indicates that the Structure needs to have an active CHAP facility in order to operate. */
-	bool mSelfSustained = false; /**< Indicates that the Structure is self contained and can operate by itself. */
 	bool mForcedIdle = false; /**< Indicates that the Structure was manually set to Idle by the user and should remain that way until the user says otherwise. */
+
+	StructureComponents::Handle mHandle; /**< Row of the Structure's state, age and requirements in the StructureComponents columns. */
+	Tile* mTile = nullptr; /**< Tile the Structure occupies. Maintained by StructureManager, nullptr when unmanaged. */
+	std::size_t mListIndex = 0; /**< Slot of the Structure in its StructureManager class list. */
 };
 
 
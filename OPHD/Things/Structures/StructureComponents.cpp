@@ -0,0 +1,63 @@
+#include "StructureComponents.h"
+
+#include "Structure.h"
+
+
+/**
+ * Takes a handle for a new structure. Its fields are set to the defaults
+ * of a structure under construction.
+ */
+StructureComponents::Handle StructureComponents::create()
+{
+	if (!mFreeHandles.empty())
+	{
+		const auto handle = mFreeHandles.back();
+		mFreeHandles.pop_back();
+
+		state[handle] = StructureState::UnderConstruction;
+		age[handle] = 0;
+		turnsToBuild[handle] = 0;
+		maxAge[handle] = 0;
+		requiresChap[handle] = true;
+		selfSustained[handle] = false;
+		populationRequired[handle] = {0, 0};
+		energyRequired[handle] = 0;
+		resourcesIn[handle] = {};
+		return handle;
+	}
+
+	state.push_back(StructureState::UnderConstruction);
+	age.push_back(0);
+	turnsToBuild.push_back(0);
+	maxAge.push_back(0);
+	requiresChap.push_back(true);
+	selfSustained.push_back(false);
+	populationRequired.push_back({0, 0});
+	energyRequired.push_back(0);
+	resourcesIn.push_back({});
+	return state.size() - 1;
+}
+
+
+/**
+ * Returns a handle so a later structure can reuse its row.
+ */
+void StructureComponents::destroy(Handle handle)
+{
+	mFreeHandles.push_back(handle);
+}
+
+
+/**
+ * Ages a structure by one turn.
+ *
+ * \return	Whether the structure was just built or just wore out.
+ */
+StructureComponents::AgeStep StructureComponents::incrementAge(Handle handle)
+{
+	const auto newAge = ++age[handle];
+
+	if (newAge == turnsToBuild[handle]) { return AgeStep::Built; }
+	if (newAge == maxAge[handle]) { return AgeStep::WornOut; }
+	return AgeStep::None;
+}
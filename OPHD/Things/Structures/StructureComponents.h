@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../../Common.h"
+#include "../../StorableResources.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * Per turn simulation fields of every Structure, stored as one column
+ * per field.
+ *
+ * Each Structure takes a handle when it's created and reads and writes
+ * these fields through it. The StructureManager's update pass walks the
+ * columns by handle so its checks don't pull whole Structure objects
+ * through the cache.
+ *
+ * \note	Handles of destroyed structures are reused. Columns only grow.
+ */
+class StructureComponents
+{
+public:
+	using Handle = std::size_t;
+
+	/**
+	 * Result of aging a structure by one turn.
+	 */
+	enum class AgeStep
+	{
+		None,
+		Built, /**< Reached the number of turns it takes to build. */
+		WornOut /**< Reached its maximum age. */
+	};
+
+public:
+	StructureComponents() = default;
+	StructureComponents(const StructureComponents&) = delete;
+	StructureComponents& operator=(const StructureComponents&) = delete;
+
+	Handle create();
+	void destroy(Handle handle);
+
+	AgeStep incrementAge(Handle handle);
+
+	std::size_t size() const { return state.size(); }
+
+	std::vector<StructureState> state;
+	std::vector<int> age;
+	std::vector<int> turnsToBuild;
+	std::vector<int> maxAge;
+	std::vector<std::uint8_t> requiresChap;
+	std::vector<std::uint8_t> selfSustained;
+	std::vector<PopulationRequirements> populationRequired;
+	std::vector<int> energyRequired;
+	std::vector<StorableResources> resourcesIn;
+
+private:
+	std::vector<Handle> mFreeHandles;
+};
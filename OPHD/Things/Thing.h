@@ -1,5 +1,8 @@
 #pragma once
 
+#include "../Cache.h"
+#include "../SessionArena.h"
+
 #include <NAS2D/Signal.h>
 #include <NAS2D/Resources/Sprite.h>
 
@@ -10,7 +13,7 @@
 /**
  * Class implementing a Thing interface.
  */
-class Thing
+class Thing : public SessionObject
 {
 public:
 	using DieCallback = NAS2D::Signals::Signal<Thing*>;
@@ -18,7 +21,7 @@ public:
 public:
 	Thing(const std::string& name, const std::string& spritePath, const std::string& initialAction) :
 		mName(name),
-		mSprite(spritePath, initialAction)
+		mSprite(spriteCache.load(spritePath, initialAction))
 	{}
 
 	virtual ~Thing()
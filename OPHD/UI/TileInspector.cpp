@@ -3,6 +3,7 @@
 #include "TextRender.h"
 #include "../Constants.h"
 #include "../Mine.h"
+#include "../Map/TileMap.h"
 
 #include <map>
 #include <sstream>
@@ -38,7 +39,7 @@ void TileInspector::update()
 
 	Window::update();
 
-	const auto* mine = mTile->mine();
+	const auto* mine = mTileMap->mine(*mTile);
 
 	auto position = mRect.startPoint() + NAS2D::Vector{5, 25};
 	drawLabelAndValue(position, "Has Mine: ", (mine ? "Yes" : "No"));
@@ -49,7 +50,7 @@ void TileInspector::update()
 		drawLabelAndValue(position, "Active: ", (mine->active() ? "Yes" : "No"));
 
 		position.y += 10;
-		drawLabelAndValue(position, "Production Rate: ", MINE_YIELD_TRANSLATION.at(mTile->mine()->productionRate()));
+		drawLabelAndValue(position, "Production Rate: ", MINE_YIELD_TRANSLATION.at(mine->productionRate()));
 	}
 
 	position = mRect.startPoint() + NAS2D::Vector{5, 62};
@@ -6,13 +6,16 @@
 #include "../Map/Tile.h"
 
 
+class TileMap;
+
+
 class TileInspector: public Window
 {
 public:
 	TileInspector();
 	~TileInspector() override;
 
-	void tile(Tile* t) { mTile = t; }
+	void tile(Tile* t, TileMap* tileMap) { mTile = t; mTileMap = tileMap; }
 
 	void update() override;
 
@@ -21,4 +24,5 @@ private:
 
 	Button btnClose;
 	Tile* mTile = nullptr;
+	TileMap* mTileMap = nullptr; /**< Mines are looked up each frame, they can be removed while the inspector is open. */
 };
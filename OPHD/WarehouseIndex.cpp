@@ -0,0 +1,86 @@
+#include "WarehouseIndex.h"
+
+#include "ProductPool.h"
+#include "Things/Structures/Warehouse.h"
+
+#include <stdexcept>
+
+
+WarehouseIndex::WarehouseIndex()
+{
+	ProductPool::changed().connect(this, &WarehouseIndex::onProductsChanged);
+}
+
+
+WarehouseIndex::~WarehouseIndex()
+{
+	ProductPool::changed().disconnect(this, &WarehouseIndex::onProductsChanged);
+}
+
+
+void WarehouseIndex::addWarehouse(Warehouse* warehouse)
+{
+	const auto* pool = &warehouse->products();
+	if (mEntries.find(pool) != mEntries.end())
+	{
+		throw std::runtime_error("WarehouseIndex::addWarehouse(): Warehouse is already indexed.");
+	}
+
+	mEntries[pool] = mByStorage.emplace(pool->availableStorage(), warehouse);
+}
+
+
+void WarehouseIndex::removeWarehouse(Warehouse* warehouse)
+{
+	const auto it = mEntries.find(&warehouse->products());
+	if (it == mEntries.end())
+	{
+		throw std::runtime_error("WarehouseIndex::removeWarehouse(): Warehouse is not indexed.");
+	}
+
+	mByStorage.erase(it->second);
+	mEntries.erase(it);
+}
+
+
+void WarehouseIndex::clear()
+{
+	mByStorage.clear();
+	mEntries.clear();
+}
+
+
+/**
+ * Gets the warehouse with the most available storage.
+ *
+ * \param	storageRequired	Amount of storage the warehouse needs to have available.
+ *
+ * \return	Returns nullptr if no warehouse has enough available storage.
+ */
+Warehouse* WarehouseIndex::find(int storageRequired) const
+{
+	if (mByStorage.empty()) { return nullptr; }
+
+	const auto& most = *mByStorage.rbegin();
+	return most.first >= storageRequired ? most.second : nullptr;
+}
+
+
+/**
+ * Moves a warehouse to its new position when its products change.
+ *
+ * \note	Pools that don't belong to an indexed warehouse, like the
+ *			copies made when simulating a transfer, are ignored.
+ */
+void WarehouseIndex::onProductsChanged(const ProductPool& pool)
+{
+	const auto it = mEntries.find(&pool);
+	if (it == mEntries.end()) { return; }
+
+	const auto available = pool.availableStorage();
+	if (it->second->first == available) { return; }
+
+	auto* warehouse = it->second->second;
+	mByStorage.erase(it->second);
+	it->second = mByStorage.emplace(available, warehouse);
+}
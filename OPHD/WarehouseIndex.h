@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+
+
+class ProductPool;
+class Warehouse;
+
+
+/**
+ * Keeps warehouses ordered by the amount of product storage they have
+ * available.
+ *
+ * Warehouses are reordered whenever the contents of their ProductPool
+ * change so finding space for a product doesn't have to look at every
+ * warehouse.
+ */
+class WarehouseIndex
+{
+public:
+	using StorageIndex = std::multimap<int, Warehouse*>;
+
+public:
+	WarehouseIndex();
+	~WarehouseIndex();
+
+	WarehouseIndex(const WarehouseIndex&) = delete;
+	WarehouseIndex& operator=(const WarehouseIndex&) = delete;
+
+	void addWarehouse(Warehouse* warehouse);
+	void removeWarehouse(Warehouse* warehouse);
+	void clear();
+
+	Warehouse* find(int storageRequired) const;
+
+	/**
+	 * Warehouses keyed by available storage. Iterate in reverse to visit
+	 * the warehouses with the most space first.
+	 */
+	const StorageIndex& byAvailableStorage() const { return mByStorage; }
+
+	std::size_t size() const { return mByStorage.size(); }
+
+private:
+	void onProductsChanged(const ProductPool& pool);
+
+	StorageIndex mByStorage;
+	std::unordered_map<const ProductPool*, StorageIndex::iterator> mEntries; /**< Position of each warehouse's pool in mByStorage. */
+};
@@ -0,0 +1,128 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+
+/**
+ * Creates a pool with one worker per hardware thread.
+ */
+WorkerPool::WorkerPool() :
+	WorkerPool(std::max(1u, std::thread::hardware_concurrency()))
+{}
+
+
+/**
+ * \param	workerCount	Number of workers including the calling thread.
+ *						A count of 1 runs every task on the calling thread.
+ */
+WorkerPool::WorkerPool(std::size_t workerCount)
+{
+	for (std::size_t worker = 1; worker < workerCount; ++worker)
+	{
+		mThreads.emplace_back(&WorkerPool::workerLoop, this, worker);
+	}
+}
+
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopping = true;
+	}
+	mWorkReady.notify_all();
+
+	for (auto& thread : mThreads)
+	{
+		thread.join();
+	}
+}
+
+
+/**
+ * Runs task(index, worker) for every index in [0, taskCount) and waits for
+ * all of them to finish.
+ *
+ * \note	If a task throws, the remaining tasks still run and the first
+ *			exception is rethrown once they're done.
+ *
+ * \warning	Not reentrant. Tasks must not call run().
+ */
+void WorkerPool::run(std::size_t taskCount, const Task& task)
+{
+	if (taskCount == 0) { return; }
+
+	if (mThreads.empty() || taskCount == 1)
+	{
+		for (std::size_t i = 0; i < taskCount; ++i)
+		{
+			task(i, 0);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mTask = &task;
+		mTaskCount = taskCount;
+		mNextTask = 0;
+		mBusyWorkers = mThreads.size();
+		mError = nullptr;
+		++mBatch;
+	}
+	mWorkReady.notify_all();
+
+	work(0);
+
+	std::exception_ptr error;
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mWorkDone.wait(lock, [this] { return mBusyWorkers == 0; });
+		mTask = nullptr;
+		error = mError;
+	}
+
+	if (error) { std::rethrow_exception(error); }
+}
+
+
+void WorkerPool::workerLoop(std::size_t worker)
+{
+	std::uint64_t lastBatch = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWorkReady.wait(lock, [this, lastBatch] { return mStopping || mBatch != lastBatch; });
+			if (mStopping) { return; }
+			lastBatch = mBatch;
+		}
+
+		work(worker);
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (--mBusyWorkers == 0) { mWorkDone.notify_one(); }
+		}
+	}
+}
+
+
+/**
+ * Takes task indexes until there are none left.
+ */
+void WorkerPool::work(std::size_t worker)
+{
+	for (auto index = mNextTask++; index < mTaskCount; index = mNextTask++)
+	{
+		try
+		{
+			(*mTask)(index, worker);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (!mError) { mError = std::current_exception(); }
+		}
+	}
+}
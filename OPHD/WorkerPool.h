@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Fixed set of threads for running independent tasks in parallel.
+ *
+ * run() hands out task indexes to the worker threads and to the calling
+ * thread, then blocks until every task has finished. Each task is told
+ * which worker runs it so callers can keep per-worker scratch state in a
+ * vector of workerCount() entries. The calling thread is always worker 0.
+ *
+ * \note	Tasks run in no particular order. Callers that need reproducible
+ *			results should write each task's result to its own slot and
+ *			merge them in index order after run() returns.
+ */
+class WorkerPool
+{
+public:
+	using Task = std::function<void(std::size_t index, std::size_t worker)>;
+
+	WorkerPool();
+	explicit WorkerPool(std::size_t workerCount);
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+	~WorkerPool();
+
+	std::size_t workerCount() const { return mThreads.size() + 1; }
+
+	void run(std::size_t taskCount, const Task& task);
+
+private:
+	void workerLoop(std::size_t worker);
+	void work(std::size_t worker);
+
+	std::vector<std::thread> mThreads;
+
+	std::mutex mMutex;
+	std::condition_variable mWorkReady;
+	std::condition_variable mWorkDone;
+
+	const Task* mTask = nullptr;
+	std::size_t mTaskCount = 0;
+	std::atomic<std::size_t> mNextTask{0};
+	std::size_t mBusyWorkers = 0;
+	std::uint64_t mBatch = 0; /**< Bumped by each run() so workers can tell new work from a spurious wakeup. */
+	bool mStopping = false;
+
+	std::exception_ptr mError; /**< First exception thrown by a task. Rethrown by run(). */
+};
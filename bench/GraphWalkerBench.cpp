@@ -0,0 +1,224 @@
+/**
+ * Times GraphWalker over synthetic tube networks of about 10,000 tubes
+ * and checks that it marks the same tiles connected as the recursive
+ * walker it replaced.
+ *
+ * Two layouts are built on the surface of the first planet in
+ * planets/PlanetAttributes.xml:
+ *  - line: a single serpentine tube, 50 rows of 200 tubes joined at
+ *    alternating ends, the worst case for recursion depth.
+ *  - grid: 100x100 tube intersections.
+ *
+ * Needs the game's data directory and a display since TileMap and
+ * structure sprites load images. Run from the directory the game runs
+ * from.
+ *
+ * Usage: graphWalkerBench [repetitions]
+ */
+
+#include "RecursiveGraphWalker.h"
+
+#include "../OPHD/Constants.h"
+#include "../OPHD/GraphWalker.h"
+#include "../OPHD/StructureManager.h"
+#include "../OPHD/Map/TileMap.h"
+#include "../OPHD/States/Planet.h"
+#include "../OPHD/Things/Structures/Tube.h"
+
+#include <NAS2D/Configuration.h>
+#include <NAS2D/Filesystem.h>
+#include <NAS2D/Utility.h>
+#include <NAS2D/Renderer/RendererOpenGL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+
+	void placeTube(TileMap& tileMap, NAS2D::Point<int> position, ConnectorDir direction)
+	{
+		auto& tile = tileMap.getTile(position, 0);
+		Utility<StructureManager>::get().addStructure(new Tube(direction, false), &tile);
+	}
+
+
+	/**
+	 * Rows of east-west tubes, joined by a north-south tube at alternating
+	 * ends. Row ends are intersections so the turns connect.
+	 */
+	void buildLine(TileMap& tileMap)
+	{
+		constexpr int RowLength = 200;
+		constexpr int RowCount = 50;
+
+		for (int row = 0; row < RowCount; ++row)
+		{
+			const int y = row * 2;
+			for (int x = 0; x < RowLength; ++x)
+			{
+				const bool rowEnd = x == 0 || x == RowLength - 1;
+				placeTube(tileMap, {x, y}, rowEnd ? ConnectorDir::CONNECTOR_INTERSECTION : ConnectorDir::CONNECTOR_RIGHT);
+			}
+
+			if (row + 1 < RowCount)
+			{
+				const int x = row % 2 == 0 ? RowLength - 1 : 0;
+				placeTube(tileMap, {x, y + 1}, ConnectorDir::CONNECTOR_LEFT);
+			}
+		}
+	}
+
+
+	void buildGrid(TileMap& tileMap)
+	{
+		for (int y = 0; y < 100; ++y)
+		{
+			for (int x = 0; x < 100; ++x)
+			{
+				placeTube(tileMap, {x, y}, ConnectorDir::CONNECTOR_INTERSECTION);
+			}
+		}
+	}
+
+
+	void clearConnected(TileMap& tileMap)
+	{
+		const auto size = tileMap.size();
+		for (int y = 0; y < size.y; ++y)
+		{
+			for (int x = 0; x < size.x; ++x)
+			{
+				tileMap.getTile({x, y}, 0).connected(false);
+			}
+		}
+	}
+
+
+	std::vector<bool> connectedFlags(TileMap& tileMap)
+	{
+		const auto size = tileMap.size();
+		std::vector<bool> flags;
+		for (int y = 0; y < size.y; ++y)
+		{
+			for (int x = 0; x < size.x; ++x)
+			{
+				flags.push_back(tileMap.getTile({x, y}, 0).connected());
+			}
+		}
+		return flags;
+	}
+
+
+	double milliseconds(Clock::duration duration)
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	}
+
+
+	/**
+	 * \return	False if the two walkers disagree.
+	 */
+	bool benchLayout(const std::string& name, TileMap& tileMap, int repetitions)
+	{
+		TileList recursiveTiles;
+		Clock::duration recursiveTime{};
+		for (int i = 0; i < repetitions; ++i)
+		{
+			clearConnected(tileMap);
+			recursiveTiles.clear();
+			const auto begin = Clock::now();
+			RecursiveGraphWalker walker({0, 0}, 0, tileMap, recursiveTiles);
+			recursiveTime += Clock::now() - begin;
+		}
+		const auto recursiveFlags = connectedFlags(tileMap);
+
+		GraphWalker graphWalker;
+		TileList tiles;
+		Clock::duration iterativeTime{};
+		for (int i = 0; i < repetitions; ++i)
+		{
+			clearConnected(tileMap);
+			tiles.clear();
+			const auto begin = Clock::now();
+			graphWalker.walk({0, 0}, 0, tileMap, tiles);
+			iterativeTime += Clock::now() - begin;
+		}
+		const auto iterativeFlags = connectedFlags(tileMap);
+
+		std::sort(recursiveTiles.begin(), recursiveTiles.end());
+		std::sort(tiles.begin(), tiles.end());
+
+		std::cout << name << ": " << tiles.size() << " tiles connected" << std::endl;
+		std::cout << "  recursive:   " << milliseconds(recursiveTime) / repetitions << " ms per walk" << std::endl;
+		std::cout << "  GraphWalker: " << milliseconds(iterativeTime) / repetitions << " ms per walk" << std::endl;
+
+		if (recursiveFlags != iterativeFlags || recursiveTiles != tiles)
+		{
+			std::cout << "ERROR: " << name << ": GraphWalker and the recursive walk connected different tiles." << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	const int repetitions = argc > 1 ? std::stoi(argv[1]) : 20;
+
+	try
+	{
+		auto& fs = Utility<Filesystem>::init<Filesystem>(argv[0], "OutpostHD", "LairWorks");
+		fs.mountSoftFail("data");
+		fs.mountSoftFail(fs.basePath() + "data");
+
+		Utility<Configuration>::init(
+			std::map<std::string, Dictionary>{
+				{
+					"graphics",
+					{{
+						{"screenwidth", constants::MINIMUM_WINDOW_WIDTH},
+						{"screenheight", constants::MINIMUM_WINDOW_HEIGHT},
+						{"bitdepth", 32},
+						{"fullscreen", false},
+						{"vsync", false}
+					}}
+				}
+			}
+		);
+
+		Utility<Renderer>::init<RendererOpenGL>("OutpostHD GraphWalker benchmark");
+
+		const auto planets = parsePlanetAttributes();
+		if (planets.empty()) { throw std::runtime_error("No planets defined in planets/PlanetAttributes.xml"); }
+		const auto& planet = planets.front();
+
+		bool passed = true;
+		for (const auto& [name, build] : {std::pair{"line", &buildLine}, std::pair{"grid", &buildGrid}})
+		{
+			TileMap tileMap(planet.mapImagePath, planet.tilesetPath, {planet.mapWidth, planet.mapHeight}, planet.maxDepth, 0, Planet::Hostility::None, false);
+			build(tileMap);
+			passed = benchLayout(name, tileMap, repetitions) && passed;
+			Utility<StructureManager>::get().dropAllStructures();
+		}
+
+		return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << "Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
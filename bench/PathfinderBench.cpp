@@ -0,0 +1,233 @@
+/**
+ * Compares GridPathfinder against MicroPather on randomly generated
+ * 300x150 route cost grids.
+ *
+ * Costs follow TileMap::routeCost(): terrain costs ROUTE_BASE_COST times
+ * (terrain + 1), roads cost 0.5 and other structures can only be entered
+ * as the start or end of a route. MicroPather is driven through the same
+ * Graph adapter TileMap used to provide, Euclidean heuristic included.
+ *
+ * Usage: pathfinderBench [seed count] [searches per seed]
+ */
+
+#include "../OPHD/Map/GridPathfinder.h"
+#include "../OPHD/Constants/Numbers.h"
+
+#include "MicroPather/micropather.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+	constexpr NAS2D::Vector<int> MapSize{300, 150};
+
+	using Clock = std::chrono::steady_clock;
+
+
+	/**
+	 * Surface terrain weighted roughly like the bundled planet maps, with
+	 * scattered structures and a few road lines.
+	 */
+	RouteCostGrid makeGrid(std::mt19937& generator)
+	{
+		const auto tileCount = static_cast<std::size_t>(MapSize.x * MapSize.y);
+
+		RouteCostGrid grid;
+		grid.size = MapSize;
+		grid.cost.resize(tileCount);
+		grid.endpointCost.resize(tileCount);
+
+		std::discrete_distribution<int> terrain{10, 40, 25, 15, 10};
+		std::uniform_int_distribution<int> percent{0, 99};
+
+		for (std::size_t i = 0; i < tileCount; ++i)
+		{
+			const auto terrainType = terrain(generator);
+			const float terrainCost = terrainType == 4 ? FLT_MAX : constants::ROUTE_BASE_COST * (static_cast<float>(terrainType) + 1.0f);
+
+			grid.endpointCost[i] = terrainCost;
+			grid.cost[i] = (terrainCost != FLT_MAX && percent(generator) < 5) ? FLT_MAX : terrainCost;
+		}
+
+		std::uniform_int_distribution<int> column{0, MapSize.x - 1};
+		std::uniform_int_distribution<int> row{0, MapSize.y - 1};
+		for (int road = 0; road < 6; ++road)
+		{
+			const auto x = column(generator);
+			const auto y = row(generator);
+			for (int i = 0; i < MapSize.x; ++i) { grid.cost[static_cast<std::size_t>(y * MapSize.x + i)] = grid.endpointCost[static_cast<std::size_t>(y * MapSize.x + i)] = 0.5f; }
+			for (int i = 0; i < MapSize.y; ++i) { grid.cost[static_cast<std::size_t>(i * MapSize.x + x)] = grid.endpointCost[static_cast<std::size_t>(i * MapSize.x + x)] = 0.5f; }
+		}
+
+		for (std::size_t i = 0; i < tileCount; ++i)
+		{
+			grid.minimumCost = std::min({grid.minimumCost, grid.cost[i], grid.endpointCost[i]});
+		}
+
+		return grid;
+	}
+
+
+	/**
+	 * micropather::Graph over a RouteCostGrid. States are addresses within
+	 * mStates so they map back to tile indexes.
+	 */
+	class GridGraph : public micropather::Graph
+	{
+	public:
+		explicit GridGraph(const RouteCostGrid& grid) :
+			mGrid{grid},
+			mStates(grid.cost.size())
+		{}
+
+		void* state(std::size_t index) { return &mStates[index]; }
+		std::size_t index(void* state) const { return static_cast<std::size_t>(static_cast<const std::uint8_t*>(state) - mStates.data()); }
+
+		void pathStartAndEnd(std::size_t start, std::size_t end) { mStart = start; mEnd = end; }
+
+		float LeastCostEstimate(void* stateStart, void* stateEnd) override
+		{
+			const auto width = static_cast<std::size_t>(mGrid.size.x);
+			const auto dx = static_cast<float>(index(stateEnd) % width) - static_cast<float>(index(stateStart) % width);
+			const auto dy = static_cast<float>(index(stateEnd) / width) - static_cast<float>(index(stateStart) / width);
+			return std::sqrt(dx * dx + dy * dy);
+		}
+
+		void AdjacentCost(void* state, std::vector<micropather::StateCost>* adjacent) override
+		{
+			const auto tile = index(state);
+			const auto width = static_cast<std::size_t>(mGrid.size.x);
+			const auto x = tile % width;
+			const auto y = tile / width;
+
+			const auto push = [&](std::size_t neighbor)
+			{
+				const bool endpoint = neighbor == mStart || neighbor == mEnd;
+				adjacent->push_back({this->state(neighbor), endpoint ? mGrid.endpointCost[neighbor] : mGrid.cost[neighbor]});
+			};
+
+			if (y > 0) { push(tile - width); }
+			if (x + 1 < width) { push(tile + 1); }
+			if (y + 1 < static_cast<std::size_t>(mGrid.size.y)) { push(tile + width); }
+			if (x > 0) { push(tile - 1); }
+		}
+
+		void PrintStateInfo(void* state) override
+		{
+			std::cout << index(state);
+		}
+
+	private:
+		const RouteCostGrid& mGrid;
+		std::vector<std::uint8_t> mStates;
+		std::size_t mStart = 0;
+		std::size_t mEnd = 0;
+	};
+
+
+	std::vector<std::pair<std::size_t, std::size_t>> makeSearches(const RouteCostGrid& grid, std::mt19937& generator, int count)
+	{
+		std::uniform_int_distribution<std::size_t> tile{0, grid.cost.size() - 1};
+		const auto passable = [&]()
+		{
+			auto index = tile(generator);
+			while (grid.endpointCost[index] == FLT_MAX) { index = tile(generator); }
+			return index;
+		};
+
+		std::vector<std::pair<std::size_t, std::size_t>> searches;
+		for (int i = 0; i < count; ++i)
+		{
+			searches.emplace_back(passable(), passable());
+		}
+		return searches;
+	}
+
+
+	double milliseconds(Clock::duration duration)
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	const int seedCount = argc > 1 ? std::stoi(argv[1]) : 4;
+	const int searchCount = argc > 2 ? std::stoi(argv[2]) : 250;
+
+	Clock::duration gridTotal{};
+	Clock::duration microPatherTotal{};
+	int mismatches = 0;
+	int microPatherWorse = 0;
+	int unreachable = 0;
+
+	GridPathfinder pathfinder;
+	GridPathfinder::Path gridPath;
+	std::vector<void*> microPatherPath;
+
+	for (int seed = 1; seed <= seedCount; ++seed)
+	{
+		std::mt19937 generator{static_cast<std::mt19937::result_type>(seed)};
+		const auto grid = makeGrid(generator);
+		const auto searches = makeSearches(grid, generator, searchCount);
+
+		GridGraph graph{grid};
+		micropather::MicroPather microPather{&graph};
+
+		Clock::duration gridSeed{};
+		Clock::duration microPatherSeed{};
+
+		for (const auto& [start, end] : searches)
+		{
+			auto begin = Clock::now();
+			const float gridCost = pathfinder.findPath(grid, start, end, gridPath);
+			gridSeed += Clock::now() - begin;
+
+			float microPatherCost = FLT_MAX;
+			graph.pathStartAndEnd(start, end);
+			begin = Clock::now();
+			const auto result = microPather.Solve(graph.state(start), graph.state(end), &microPatherPath, &microPatherCost);
+			microPatherSeed += Clock::now() - begin;
+
+			const bool microPatherFound = result == micropather::MicroPather::SOLVED || result == micropather::MicroPather::START_END_SAME;
+			if (!microPatherFound) { microPatherCost = FLT_MAX; }
+
+			if (gridCost == FLT_MAX && !microPatherFound) { ++unreachable; continue; }
+
+			// GridPathfinder must always find the cheapest route. MicroPather's
+			// heuristic can overestimate next to roads so it may do worse.
+			if (gridCost > microPatherCost + 0.001f) { ++mismatches; }
+			else if (microPatherCost > gridCost + 0.001f) { ++microPatherWorse; }
+		}
+
+		std::cout << "seed " << seed << ": GridPathfinder " << milliseconds(gridSeed) << " ms, MicroPather " << milliseconds(microPatherSeed) << " ms (" << searches.size() << " searches)" << std::endl;
+
+		gridTotal += gridSeed;
+		microPatherTotal += microPatherSeed;
+	}
+
+	const auto totalSearches = seedCount * searchCount;
+	std::cout << std::endl;
+	std::cout << "GridPathfinder: " << milliseconds(gridTotal) << " ms total, " << milliseconds(gridTotal) * 1000.0 / totalSearches << " us per search" << std::endl;
+	std::cout << "MicroPather:    " << milliseconds(microPatherTotal) << " ms total, " << milliseconds(microPatherTotal) * 1000.0 / totalSearches << " us per search" << std::endl;
+	std::cout << "Unreachable pairs: " << unreachable << ", MicroPather routes costlier than GridPathfinder: " << microPatherWorse << std::endl;
+
+	if (mismatches > 0)
+	{
+		std::cout << "ERROR: GridPathfinder returned a costlier route than MicroPather " << mismatches << " times." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../OPHD/Common.h"
+#include "../OPHD/Map/Tile.h"
+
+#include <NAS2D/Renderer/Point.h>
+
+
+class TileMap;
+
+
+/**
+ * The recursive GraphWalker that GraphWalker replaced, kept to check that
+ * both mark the same tiles as connected.
+ *
+ * \warning	Recursion depth equals the number of connected tiles.
+ */
+class RecursiveGraphWalker
+{
+public:
+	RecursiveGraphWalker(const NAS2D::Point<int>&, int, TileMap&, TileList&);
+	~RecursiveGraphWalker() = default;
+
+private:
+	RecursiveGraphWalker() = delete;
+	RecursiveGraphWalker(RecursiveGraphWalker&) = delete;
+	RecursiveGraphWalker& operator=(const RecursiveGraphWalker&) = delete;
+
+private:
+	void walkGraph();
+	void check(NAS2D::Point<int> point, int depth, Direction direction);
+
+private:
+	TileMap& mTileMap;
+	Tile& mThisTile;
+	TileList& mTileList;
+
+	NAS2D::Point<int> mGridPosition;
+	int mDepth{ 0 };
+};
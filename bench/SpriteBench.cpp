@@ -0,0 +1,118 @@
+/**
+ * Measures what building a Thing's sprite costs: parsing the .sprite file
+ * the way Thing used to, against copying the parsed sprite out of
+ * spriteCache the way it does now.
+ *
+ * Covers the sprites placed most often: above ground tube intersections,
+ * roads and residences. Prints sizeof(NAS2D::Sprite), which is the fixed
+ * part of every copy. Whatever a Sprite holds on the heap (frame lists,
+ * action names) is copied as well and shows up in the copy time.
+ *
+ * Needs the game's data directory and a display since sprites load their
+ * sheet images. Run from the directory the game runs from.
+ *
+ * Usage: spriteBench [sprites per path]
+ */
+
+#include "../OPHD/Cache.h"
+#include "../OPHD/Constants.h"
+
+#include <NAS2D/Configuration.h>
+#include <NAS2D/Filesystem.h>
+#include <NAS2D/Utility.h>
+#include <NAS2D/Renderer/RendererOpenGL.h>
+#include <NAS2D/Resources/Sprite.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+using namespace NAS2D;
+
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+
+	double microseconds(Clock::duration duration)
+	{
+		return std::chrono::duration<double, std::micro>(duration).count();
+	}
+
+
+	void benchSprite(const std::string& path, const std::string& action, int count)
+	{
+		std::vector<std::unique_ptr<Sprite>> sprites;
+		sprites.reserve(static_cast<std::size_t>(count));
+
+		auto begin = Clock::now();
+		for (int i = 0; i < count; ++i)
+		{
+			sprites.push_back(std::make_unique<Sprite>(path, action));
+		}
+		const auto parseTime = Clock::now() - begin;
+		sprites.clear();
+
+		// Warm the cache so only the copies are timed.
+		spriteCache.load(path, action);
+
+		begin = Clock::now();
+		for (int i = 0; i < count; ++i)
+		{
+			sprites.push_back(std::make_unique<Sprite>(spriteCache.load(path, action)));
+		}
+		const auto copyTime = Clock::now() - begin;
+
+		std::cout << path << " (" << action << ")" << std::endl;
+		std::cout << "  parse: " << microseconds(parseTime) / count << " us per sprite" << std::endl;
+		std::cout << "  copy:  " << microseconds(copyTime) / count << " us per sprite" << std::endl;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	const int count = argc > 1 ? std::stoi(argv[1]) : 10000;
+
+	try
+	{
+		auto& fs = Utility<Filesystem>::init<Filesystem>(argv[0], "OutpostHD", "LairWorks");
+		fs.mountSoftFail("data");
+		fs.mountSoftFail(fs.basePath() + "data");
+
+		Utility<Configuration>::init(
+			std::map<std::string, Dictionary>{
+				{
+					"graphics",
+					{{
+						{"screenwidth", constants::MINIMUM_WINDOW_WIDTH},
+						{"screenheight", constants::MINIMUM_WINDOW_HEIGHT},
+						{"bitdepth", 32},
+						{"fullscreen", false},
+						{"vsync", false}
+					}}
+				}
+			}
+		);
+
+		Utility<Renderer>::init<RendererOpenGL>("OutpostHD sprite benchmark");
+
+		std::cout << "sizeof(NAS2D::Sprite): " << sizeof(Sprite) << " bytes" << std::endl;
+
+		benchSprite("structures/tubes.sprite", constants::AG_TUBE_INTERSECTION, count);
+		benchSprite("structures/roads.sprite", constants::STRUCTURE_STATE_CONSTRUCTION, count);
+		benchSprite("structures/residential_1.sprite", constants::STRUCTURE_STATE_CONSTRUCTION, count);
+
+		return EXIT_SUCCESS;
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << "Error: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}